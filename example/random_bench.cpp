@@ -0,0 +1,334 @@
+// Benchmark of include/random.hpp: ns/value and GB/s for every engine x type x API,
+// each next to the std baseline that does the same job with the same engine
+//
+// usage: random_bench [--quick] [--filter <text>] [--json <file>] [--csv <file>]
+//   --quick   only the L1/L2 sized buffers and shorter measurements
+//   --filter  only run cases whose "engine/type/api" contains the text
+//
+// build with optimizations, e.g. cl /std:c++latest /O2 /EHsc random_bench.cpp
+//                            or g++ -std=c++23 -O2 random_bench.cpp -ltbb
+
+#include <cstdio>
+#include <format>
+#include <fstream>
+#include <print>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include "../include/random.hpp"
+#include "../include/timer.hpp"
+
+struct Result {
+    std::string engine, type, api, impl;
+    size_t elements, bytes;
+    double ns_per_value, gb_per_s;
+};
+
+struct Options {
+    bool quick = false;
+    std::string filter, json_path, csv_path;
+};
+
+// buffer footprints meant to sit in L1, L2, L3 and DRAM on a typical desktop CPU
+constexpr size_t footprints[] = {16 << 10, 256 << 10, 4 << 20, 64 << 20};
+
+template <typename T>
+struct TypeInfo;
+
+template <>
+struct TypeInfo<uint8_t> {
+    static constexpr std::string_view name = "uint8";
+    static constexpr uint8_t min = 0, max = 255;
+    using StdDist = std::uniform_int_distribution<uint16_t>;
+};
+
+template <>
+struct TypeInfo<int32_t> {
+    static constexpr std::string_view name = "int32";
+    static constexpr int32_t min = -1000, max = 1000;
+    using StdDist = std::uniform_int_distribution<int32_t>;
+};
+
+template <>
+struct TypeInfo<uint64_t> {
+    static constexpr std::string_view name = "uint64";
+    static constexpr uint64_t min = 0, max = std::numeric_limits<uint64_t>::max();
+    using StdDist = std::uniform_int_distribution<uint64_t>;
+};
+
+template <>
+struct TypeInfo<float> {
+    static constexpr std::string_view name = "float";
+    static constexpr float min = 0, max = 1;
+    using StdDist = std::uniform_real_distribution<float>;
+};
+
+template <>
+struct TypeInfo<double> {
+    static constexpr std::string_view name = "double";
+    static constexpr double min = 0, max = 1;
+    using StdDist = std::uniform_real_distribution<double>;
+};
+
+template <typename E>
+constexpr std::string_view engine_name = "unknown";
+template <>
+constexpr std::string_view engine_name<std::minstd_rand> = "minstd_rand";
+template <>
+constexpr std::string_view engine_name<std::mt19937> = "mt19937";
+template <>
+constexpr std::string_view engine_name<std::mt19937_64> = "mt19937_64";
+template <>
+constexpr std::string_view engine_name<API_Random::MinstdRand> = "MinstdRand";
+template <>
+constexpr std::string_view engine_name<API_Random::Philox4x32> = "Philox4x32";
+template <>
+constexpr std::string_view engine_name<API_Random::BufferedRandom<std::mt19937_64>> = "BufferedRandom<mt19937_64>";
+
+using Engines = std::tuple<std::minstd_rand, std::mt19937, std::mt19937_64, API_Random::MinstdRand, API_Random::Philox4x32,
+                           API_Random::BufferedRandom<std::mt19937_64>>;
+using Types = std::tuple<uint8_t, int32_t, uint64_t, float, double>;
+
+constexpr uint32_t seed = 1337;
+
+// stores through a volatile so the measured work can't be dropped as dead code
+template <typename T>
+static void keep(const T& value) {
+    static volatile T sink;
+    sink = value;
+    (void)sink;
+}
+
+// best time of several repetitions, each one long enough to hide the clock resolution
+static double ns_per_run(auto&& body, bool quick) {
+    const double min_ns = quick ? 5e6 : 2e7;
+    const int repetitions = quick ? 3 : 5;
+
+    Timer<Measurements::ns> timer;
+    size_t runs = 1;
+    double best = std::numeric_limits<double>::max();
+
+    for (int rep = 0; rep < repetitions;) {
+        timer.start();
+        for (size_t i = 0; i < runs; ++i) {
+            body();
+        }
+        timer.stop();
+
+        if (const double elapsed = timer.get_duration().count(); elapsed < min_ns) {
+            runs *= 2;
+        } else {
+            best = std::min(best, elapsed / static_cast<double>(runs));
+            ++rep;
+        }
+    }
+    return best;
+}
+
+class Suite {
+  public:
+    explicit Suite(Options options) : m_options(std::move(options)) {}
+
+    void run() {
+        std::println("{:<28} {:<7} {:<14} {:<9} {:>10} {:>10} {:>9}", "engine", "type", "api", "impl", "elements", "ns/value", "GB/s");
+        std::apply([&](auto... engines) { (run_engine<decltype(engines)>(), ...); }, Engines{});
+    }
+
+    [[nodiscard]] const std::vector<Result>& results() const noexcept { return m_results; }
+
+  private:
+    Options m_options;
+    std::vector<Result> m_results;
+
+    template <typename E>
+    void run_engine() {
+        std::apply([&](auto... types) { (run_type<E, decltype(types)>(), ...); }, Types{});
+        run_strings<E>();
+    }
+
+    [[nodiscard]] bool selected(std::string_view engine, std::string_view type, std::string_view api) const {
+        return m_options.filter.empty() || std::format("{}/{}/{}", engine, type, api).contains(m_options.filter);
+    }
+
+    [[nodiscard]] std::vector<size_t> sizes(size_t value_size) const {
+        std::vector<size_t> result;
+        for (const size_t bytes : footprints) {
+            if (!m_options.quick || bytes <= (256 << 10)) {
+                result.push_back(bytes / value_size);
+            }
+        }
+        return result;
+    }
+
+    void record(std::string_view engine, std::string_view type, std::string_view api, std::string_view impl, size_t elements,
+                size_t value_size, double ns) {
+        const Result& result = m_results.emplace_back(std::string(engine), std::string(type), std::string(api), std::string(impl),
+                                                      elements, elements * value_size, ns / static_cast<double>(elements),
+                                                      static_cast<double>(elements * value_size) / ns);
+        std::println("{:<28} {:<7} {:<14} {:<9} {:>10} {:>10.3f} {:>9.3f}", result.engine, result.type, result.api, result.impl,
+                     result.elements, result.ns_per_value, result.gb_per_s);
+    }
+
+    // measures the Random_t call and the std baseline, both on a fresh engine with the same seed
+    template <typename E, typename T>
+    void compare(std::string_view api, size_t count, auto&& ours, auto&& baseline) {
+        if (!selected(engine_name<E>, TypeInfo<T>::name, api)) {
+            return;
+        }
+
+        Random_t<E> rand{seed};
+        record(engine_name<E>, TypeInfo<T>::name, api, "Random_t", count, sizeof(T), ns_per_run([&] { ours(rand); }, m_options.quick));
+
+        E engine(seed);
+        record(engine_name<E>, TypeInfo<T>::name, api, "std", count, sizeof(T), ns_per_run([&] { baseline(engine); }, m_options.quick));
+    }
+
+    template <typename E, typename T>
+    void run_type() {
+        using Info = TypeInfo<T>;
+        typename Info::StdDist dist(Info::min, Info::max);
+
+        for (const size_t count : sizes(sizeof(T))) {
+            std::vector<T> buffer(count);
+
+            compare<E, T>(
+                "in_range", count,
+                [&](Random_t<E>& rand) {
+                    for (T& value : buffer) {
+                        value = rand.template in_range<T>(Info::min, Info::max);
+                    }
+                    keep(buffer.back());
+                },
+                [&](E& engine) {
+                    for (T& value : buffer) {
+                        value = static_cast<T>(dist(engine));
+                    }
+                    keep(buffer.back());
+                });
+
+            compare<E, T>(
+                "fill_range", count,
+                [&](Random_t<E>& rand) {
+                    rand.fill_range(buffer, Info::min, Info::max);
+                    keep(buffer.back());
+                },
+                [&](E& engine) {
+                    std::ranges::generate(buffer, [&] { return static_cast<T>(dist(engine)); });
+                    keep(buffer.back());
+                });
+
+            compare<E, T>(
+                "shuffle_range", count,
+                [&](Random_t<E>& rand) {
+                    rand.shuffle_range(buffer);
+                    keep(buffer.back());
+                },
+                [&](E& engine) {
+                    std::ranges::shuffle(buffer, engine);
+                    keep(buffer.back());
+                });
+
+            std::uniform_int_distribution<size_t> index(0, count - 1);
+            compare<E, T>(
+                "get_elem", count,
+                [&](Random_t<E>& rand) {
+                    T sum{};
+                    for (size_t i = 0; i < count; ++i) {
+                        sum += rand.get_elem(buffer);
+                    }
+                    keep(sum);
+                },
+                [&](E& engine) {
+                    T sum{};
+                    for (size_t i = 0; i < count; ++i) {
+                        sum += buffer[index(engine)];
+                    }
+                    keep(sum);
+                });
+        }
+    }
+
+    template <typename E>
+    void run_strings() {
+        const std::string_view alnum = API_Random::Charsets::alnum.view();
+        if (!selected(engine_name<E>, "char", "get_string")) {
+            return;
+        }
+
+        for (const size_t count : sizes(sizeof(char))) {
+            std::uniform_int_distribution<size_t> index(0, alnum.size() - 1);
+
+            Random_t<E> rand{seed};
+            record(engine_name<E>, "char", "get_string", "Random_t", count, sizeof(char),
+                   ns_per_run([&] { keep(rand.get_string(count).back()); }, m_options.quick));
+
+            E engine(seed);
+            const auto baseline = [&] {
+                std::string str(count, '\0');
+                for (char& c : str) {
+                    c = alnum[index(engine)];
+                }
+                keep(str.back());
+            };
+            record(engine_name<E>, "char", "get_string", "std", count, sizeof(char), ns_per_run(baseline, m_options.quick));
+        }
+    }
+};
+
+static void write_json(const std::string& path, const std::vector<Result>& results) {
+    std::ofstream out(path);
+    out << "[\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        out << std::format(
+            R"(  {{"engine": "{}", "type": "{}", "api": "{}", "impl": "{}", "elements": {}, "bytes": {}, "ns_per_value": {}, "gb_per_s": {}}}{})",
+            r.engine, r.type, r.api, r.impl, r.elements, r.bytes, r.ns_per_value, r.gb_per_s, i + 1 < results.size() ? ",\n" : "\n");
+    }
+    out << "]\n";
+}
+
+static void write_csv(const std::string& path, const std::vector<Result>& results) {
+    std::ofstream out(path);
+    out << "engine,type,api,impl,elements,bytes,ns_per_value,gb_per_s\n";
+    for (const Result& r : results) {
+        out << std::format("\"{}\",{},{},{},{},{},{},{}\n", r.engine, r.type, r.api, r.impl, r.elements, r.bytes, r.ns_per_value, r.gb_per_s);
+    }
+}
+
+static bool parse_args(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        if (arg == "--quick") {
+            options.quick = true;
+        } else if (i + 1 < argc && arg == "--filter") {
+            options.filter = argv[++i];
+        } else if (i + 1 < argc && arg == "--json") {
+            options.json_path = argv[++i];
+        } else if (i + 1 < argc && arg == "--csv") {
+            options.csv_path = argv[++i];
+        } else {
+            std::println(stderr, "usage: {} [--quick] [--filter <text>] [--json <file>] [--csv <file>]", argv[0]);
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parse_args(argc, argv, options)) {
+        return 1;
+    }
+
+    Suite suite(options);
+    suite.run();
+
+    if (!options.json_path.empty()) {
+        write_json(options.json_path, suite.results());
+    }
+    if (!options.csv_path.empty()) {
+        write_csv(options.csv_path, suite.results());
+    }
+}
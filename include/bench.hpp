@@ -0,0 +1,753 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <cstdlib>
+#include <format>
+#include <fstream>
+#include <istream>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "timer.hpp"
+
+#ifdef _MSC_VER
+	#include <intrin.h>
+#endif
+
+namespace Bench
+{
+	// keeps a value alive as if it were read by something the optimizer can't see
+	template <typename T>
+	inline void do_not_optimize(T&& value) noexcept
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : : "r,m"(value) : "memory");
+#else
+		static const void* volatile sink;
+		sink = &value;
+		_ReadWriteBarrier();
+#endif
+	}
+
+	// forces pending writes to memory before the next measured step
+	inline void clobber_memory() noexcept
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : : : "memory");
+#else
+		_ReadWriteBarrier();
+#endif
+	}
+
+	struct Options
+	{
+		std::chrono::nanoseconds sample_time	= std::chrono::milliseconds(10);
+		std::chrono::nanoseconds warmup_time	= std::chrono::milliseconds(50);
+		size_t					 samples		= 30;
+		double					 outlier_fence	= 1.5;
+		uint64_t				 items_per_op	= 1;
+		uint64_t				 bytes_per_op	= 0;
+	};
+
+	struct Result
+	{
+		std::string name;
+		uint64_t	iterations = 0;
+		size_t		samples	   = 0;
+		size_t		outliers   = 0;
+
+		double ns_per_op	   = 0;
+		double median_ns	   = 0;
+		double min_ns		   = 0;
+		double max_ns		   = 0;
+		double stddev_ns	   = 0;
+		double ci95_low_ns	   = 0;
+		double ci95_high_ns	   = 0;
+		double items_per_second = 0;
+		double bytes_per_second = 0;
+
+		std::vector<double> samples_ns; // per-op time of every kept sample, sorted
+
+		[[nodiscard]] std::string summary() const
+		{
+			auto line = std::format("{}: {:.3f} ns/op (95% CI {:.3f} .. {:.3f}, median {:.3f}, {} x {} iterations, {} outliers)", name,
+									ns_per_op, ci95_low_ns, ci95_high_ns, median_ns, samples, iterations, outliers);
+			if (bytes_per_second > 0)
+				line += std::format(", {:.3f} GB/s", bytes_per_second / 1e9);
+			else
+				line += std::format(", {:.3f} M items/s", items_per_second / 1e6);
+			return line;
+		}
+	};
+
+	namespace _detail
+	{
+		// two-sided 95% Student t quantiles for 1 .. 30 degrees of freedom
+		inline constexpr std::array<double, 30> t95 = {12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+													   2.201,  2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+													   2.080,  2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042};
+
+		[[nodiscard]] inline double t_quantile(size_t degrees) noexcept
+		{
+			return degrees == 0 ? 0.0 : degrees <= t95.size() ? t95[degrees - 1] : 1.96;
+		}
+
+		[[nodiscard]] inline double quantile(const std::vector<double>& sorted, double q) noexcept
+		{
+			const double pos   = q * static_cast<double>(sorted.size() - 1);
+			const size_t lower = static_cast<size_t>(pos);
+			const size_t upper = std::min(lower + 1, sorted.size() - 1);
+			return sorted[lower] + (sorted[upper] - sorted[lower]) * (pos - static_cast<double>(lower));
+		}
+	} // namespace _detail
+
+	// times `fn` in batches sized to `sample_time`, drops samples outside the Tukey fences
+	// and reports the mean cost per call with a 95% confidence interval
+	template <typename ClockType = std::chrono::steady_clock, typename Fn>
+	Result run(std::string_view name, Fn&& fn, const Options& options = {})
+	{
+		Timer<Measurements::ns, ClockType> timer;
+
+		const auto time_batch = [&](uint64_t iterations) {
+			timer.start();
+			for (uint64_t i = 0; i < iterations; ++i)
+			{
+				fn();
+				clobber_memory();
+			}
+			timer.stop();
+			return timer.get_duration().count();
+		};
+
+		const double target_ns = static_cast<double>(options.sample_time.count());
+		const double warmup_ns = static_cast<double>(options.warmup_time.count());
+
+		for (double spent = 0; spent < warmup_ns;)
+			spent += time_batch(1);
+
+		uint64_t iterations = 1;
+		for (double elapsed = time_batch(iterations); elapsed < target_ns; elapsed = time_batch(iterations))
+		{
+			const double scale = elapsed > 0 ? target_ns * 1.2 / elapsed : 10.0;
+			iterations		   = static_cast<uint64_t>(static_cast<double>(iterations) * std::clamp(scale, 1.5, 10.0)) + 1;
+		}
+
+		std::vector<double> per_op(std::max<size_t>(options.samples, 1));
+		for (double& sample : per_op)
+			sample = time_batch(iterations) / static_cast<double>(iterations);
+
+		std::ranges::sort(per_op);
+		const double q1	   = _detail::quantile(per_op, 0.25);
+		const double q3	   = _detail::quantile(per_op, 0.75);
+		const double lower = q1 - options.outlier_fence * (q3 - q1);
+		const double upper = q3 + options.outlier_fence * (q3 - q1);
+
+		std::vector<double> kept;
+		std::ranges::copy_if(per_op, std::back_inserter(kept), [&](double ns) { return ns >= lower && ns <= upper; });
+
+		Result result;
+		result.name		  = name;
+		result.iterations = iterations;
+		result.samples	  = kept.size();
+		result.outliers	  = per_op.size() - kept.size();
+		result.samples_ns = kept;
+
+		const double count = static_cast<double>(kept.size());
+		const double mean  = std::accumulate(kept.begin(), kept.end(), 0.0) / count;
+		double		 m2	   = 0;
+		for (const double ns : kept)
+			m2 += (ns - mean) * (ns - mean);
+
+		result.ns_per_op = mean;
+		result.median_ns = _detail::quantile(kept, 0.5);
+		result.min_ns	 = kept.front();
+		result.max_ns	 = kept.back();
+		result.stddev_ns = kept.size() > 1 ? std::sqrt(m2 / (count - 1)) : 0.0;
+
+		const double half_width = _detail::t_quantile(kept.size() - 1) * result.stddev_ns / std::sqrt(count);
+		result.ci95_low_ns		= mean - half_width;
+		result.ci95_high_ns		= mean + half_width;
+
+		if (mean > 0)
+		{
+			result.items_per_second = static_cast<double>(options.items_per_op) * 1e9 / mean;
+			result.bytes_per_second = static_cast<double>(options.bytes_per_op) * 1e9 / mean;
+		}
+		return result;
+	}
+
+	// build environment stamped into every exported report
+	struct Metadata
+	{
+		std::string compiler;
+		std::string flags;
+		std::string cpu;
+		std::string commit;
+		std::string date;
+
+		// flags and commit come from BENCH_BUILD_FLAGS / BENCH_GIT_COMMIT when defined at build time,
+		// the commit otherwise from the GIT_COMMIT environment variable
+		[[nodiscard]] static Metadata current()
+		{
+			Metadata metadata;
+#if defined(__clang__)
+			metadata.compiler = "clang " __clang_version__;
+#elif defined(__GNUC__)
+			metadata.compiler = "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+			metadata.compiler = std::format("msvc {}", _MSC_FULL_VER);
+#endif
+#ifdef BENCH_BUILD_FLAGS
+			metadata.flags = BENCH_BUILD_FLAGS;
+#endif
+#ifdef NDEBUG
+			metadata.flags += metadata.flags.empty() ? "NDEBUG" : " NDEBUG";
+#endif
+#ifdef BENCH_GIT_COMMIT
+			metadata.commit = BENCH_GIT_COMMIT;
+#else
+			if (const char* commit = std::getenv("GIT_COMMIT"))
+				metadata.commit = commit;
+#endif
+			metadata.cpu  = cpu_model();
+			metadata.date = std::format("{:%FT%TZ}", std::chrono::floor<std::chrono::seconds>(std::chrono::system_clock::now()));
+			return metadata;
+		}
+
+	  private:
+		[[nodiscard]] static std::string cpu_model()
+		{
+#if TIMER_HAS_TSC
+			std::array<unsigned int, 12> brand{};
+	#ifdef _MSC_VER
+			int regs[4] = {};
+			__cpuid(regs, 0x80000000);
+			if (static_cast<unsigned int>(regs[0]) < 0x80000004)
+				return "unknown";
+			for (unsigned int leaf = 0; leaf < 3; ++leaf)
+				__cpuid(reinterpret_cast<int*>(&brand[leaf * 4]), static_cast<int>(0x80000002 + leaf));
+	#else
+			if (__get_cpuid_max(0x80000000, nullptr) < 0x80000004)
+				return "unknown";
+			for (unsigned int leaf = 0; leaf < 3; ++leaf)
+				__get_cpuid(0x80000002 + leaf, &brand[leaf * 4], &brand[leaf * 4 + 1], &brand[leaf * 4 + 2], &brand[leaf * 4 + 3]);
+	#endif
+			std::string model(reinterpret_cast<const char*>(brand.data()), sizeof(brand));
+			model.resize(model.find('\0') == std::string::npos ? model.size() : model.find('\0'));
+			const auto first = model.find_first_not_of(' ');
+			return first == std::string::npos ? "unknown" : model.substr(first, model.find_last_not_of(' ') - first + 1);
+#else
+			return "unknown";
+#endif
+		}
+	};
+
+	struct Report
+	{
+		Metadata			metadata = Metadata::current();
+		std::vector<Result> results;
+	};
+
+	// one result per BenchTimer histogram; carries the distribution summary but no raw samples
+	template <TimeMeasure_t M, typename ClockType, size_t LapCapacity>
+	[[nodiscard]] std::vector<Result> results(const BenchTimer<M, ClockType, LapCapacity>& timer)
+	{
+		std::vector<Result> results;
+		for (const auto& [title, histogram] : timer.get_histograms())
+		{
+			if (histogram.count() == 0)
+				continue;
+
+			Result&		 result = results.emplace_back();
+			const double count	= static_cast<double>(histogram.count());
+			result.name			= title;
+			result.iterations	= 1;
+			result.samples		= histogram.count();
+			result.ns_per_op	= histogram.mean();
+			result.median_ns	= static_cast<double>(histogram.percentile(50));
+			result.min_ns		= static_cast<double>(histogram.min());
+			result.max_ns		= static_cast<double>(histogram.max());
+			result.stddev_ns	= count > 1 ? histogram.stddev() * std::sqrt(count / (count - 1)) : 0.0;
+
+			const double half_width = _detail::t_quantile(result.samples - 1) * result.stddev_ns / std::sqrt(count);
+			result.ci95_low_ns		= result.ns_per_op - half_width;
+			result.ci95_high_ns		= result.ns_per_op + half_width;
+			result.items_per_second = result.ns_per_op > 0 ? 1e9 / result.ns_per_op : 0.0;
+		}
+		std::ranges::sort(results, {}, &Result::name);
+		return results;
+	}
+
+	namespace _detail
+	{
+		inline constexpr std::array<std::pair<std::string_view, double Result::*>, 9> result_fields = {{
+			{"ns_per_op", &Result::ns_per_op},
+			{"median_ns", &Result::median_ns},
+			{"min_ns", &Result::min_ns},
+			{"max_ns", &Result::max_ns},
+			{"stddev_ns", &Result::stddev_ns},
+			{"ci95_low_ns", &Result::ci95_low_ns},
+			{"ci95_high_ns", &Result::ci95_high_ns},
+			{"items_per_second", &Result::items_per_second},
+			{"bytes_per_second", &Result::bytes_per_second},
+		}};
+
+		inline constexpr std::array<std::pair<std::string_view, std::string Metadata::*>, 5> metadata_fields = {{
+			{"compiler", &Metadata::compiler},
+			{"flags", &Metadata::flags},
+			{"cpu", &Metadata::cpu},
+			{"commit", &Metadata::commit},
+			{"date", &Metadata::date},
+		}};
+
+		[[nodiscard]] inline std::string json_string(std::string_view text)
+		{
+			std::string out = "\"";
+			for (const char c : text)
+			{
+				if (c == '"' || c == '\\')
+					(out += '\\') += c;
+				else if (static_cast<unsigned char>(c) < 0x20)
+					out += std::format("\\u{:04x}", static_cast<unsigned>(c));
+				else
+					out += c;
+			}
+			return out += '"';
+		}
+
+		// JSON has no NaN or infinity, those are written as null
+		[[nodiscard]] inline std::string json_number(double value)
+		{
+			return std::isfinite(value) ? std::format("{}", value) : "null";
+		}
+
+		[[nodiscard]] inline std::string csv_field(std::string_view text)
+		{
+			std::string out = "\"";
+			for (const char c : text)
+			{
+				if (c == '"')
+					out += '"';
+				out += c;
+			}
+			return out += '"';
+		}
+
+		// reads back what write_json() produces; unknown keys are skipped
+		class JsonReader
+		{
+		  public:
+			explicit JsonReader(std::string text)
+				: m_text(std::move(text))
+			{
+			}
+
+			void skip_whitespace() noexcept
+			{
+				m_pos = std::min(m_text.find_first_not_of(" \t\r\n", m_pos), m_text.size());
+			}
+
+			bool consume(char c) noexcept
+			{
+				skip_whitespace();
+				if (m_pos < m_text.size() && m_text[m_pos] == c)
+				{
+					++m_pos;
+					return true;
+				}
+				return false;
+			}
+
+			void expect(char c)
+			{
+				if (!consume(c))
+					fail(std::format("expected '{}'", c));
+			}
+
+			[[nodiscard]] std::string string()
+			{
+				expect('"');
+				std::string out;
+				while (m_pos < m_text.size() && m_text[m_pos] != '"')
+				{
+					const char c = m_text[m_pos++];
+					if (c != '\\')
+					{
+						out += c;
+						continue;
+					}
+					if (m_pos >= m_text.size())
+						break;
+
+					switch (const char escaped = m_text[m_pos++])
+					{
+						case 'n': out += '\n'; break;
+						case 't': out += '\t'; break;
+						case 'r': out += '\r'; break;
+						case 'b': out += '\b'; break;
+						case 'f': out += '\f'; break;
+						case 'u': append_utf8(out, hex4()); break;
+						default: out += escaped; break;
+					}
+				}
+				expect('"');
+				return out;
+			}
+
+			// null reads back as NaN
+			[[nodiscard]] double number()
+			{
+				skip_whitespace();
+				if (m_text.compare(m_pos, 4, "null") == 0)
+				{
+					m_pos += 4;
+					return std::numeric_limits<double>::quiet_NaN();
+				}
+				return parse<double>("expected a number");
+			}
+
+			// counts are parsed as integers so values above 2^53 survive the round trip
+			template <std::unsigned_integral T>
+			[[nodiscard]] T integer()
+			{
+				skip_whitespace();
+				return parse<T>("expected an unsigned integer");
+			}
+
+			void object(auto&& on_key)
+			{
+				expect('{');
+				if (consume('}'))
+					return;
+				do
+				{
+					const std::string key = string();
+					expect(':');
+					on_key(key);
+				} while (consume(','));
+				expect('}');
+			}
+
+			void array(auto&& on_item)
+			{
+				expect('[');
+				if (consume(']'))
+					return;
+				do
+					on_item();
+				while (consume(','));
+				expect(']');
+			}
+
+			void skip_value()
+			{
+				skip_whitespace();
+				const char c = m_pos < m_text.size() ? m_text[m_pos] : '\0';
+				if (c == '"')
+					(void)string();
+				else if (c == '{')
+					object([&](const std::string&) { skip_value(); });
+				else if (c == '[')
+					array([&] { skip_value(); });
+				else if (c == 't' || c == 'f' || c == 'n')
+					m_pos = std::min(m_text.find_first_of(",}] \t\r\n", m_pos), m_text.size());
+				else
+					(void)number();
+			}
+
+			[[noreturn]] void fail(std::string_view what) const
+			{
+				throw std::runtime_error(std::format("Bench: malformed report, {} at offset {}", what, m_pos));
+			}
+
+		  private:
+			std::string m_text;
+			size_t		m_pos = 0;
+
+			template <typename T>
+			[[nodiscard]] T parse(std::string_view what)
+			{
+				T value{};
+				const auto [end, error] = std::from_chars(m_text.data() + m_pos, m_text.data() + m_text.size(), value);
+				if (error != std::errc{})
+					fail(what);
+				m_pos = static_cast<size_t>(end - m_text.data());
+				return value;
+			}
+
+			[[nodiscard]] unsigned hex4()
+			{
+				unsigned value = 0;
+				if (m_pos + 4 > m_text.size() || std::from_chars(m_text.data() + m_pos, m_text.data() + m_pos + 4, value, 16).ptr != m_text.data() + m_pos + 4)
+					fail("bad \\u escape");
+				m_pos += 4;
+				return value;
+			}
+
+			static void append_utf8(std::string& out, unsigned code)
+			{
+				if (code < 0x80)
+					out += static_cast<char>(code);
+				else if (code < 0x800)
+					out += {static_cast<char>(0xc0 | code >> 6), static_cast<char>(0x80 | (code & 0x3f))};
+				else
+					out += {static_cast<char>(0xe0 | code >> 12), static_cast<char>(0x80 | (code >> 6 & 0x3f)), static_cast<char>(0x80 | (code & 0x3f))};
+			}
+		};
+	} // namespace _detail
+
+	inline void write_json(std::ostream& out, const Report& report)
+	{
+		out << "{\n  \"metadata\": {";
+		for (bool first = true; const auto& [key, field] : _detail::metadata_fields)
+		{
+			out << std::format("{}\"{}\": {}", first ? "" : ", ", key, _detail::json_string(report.metadata.*field));
+			first = false;
+		}
+		out << "},\n  \"results\": [";
+
+		for (bool first = true; const Result& result : report.results)
+		{
+			out << std::format("{}\n    {{\"name\": {}, \"iterations\": {}, \"samples\": {}, \"outliers\": {}", first ? "" : ",",
+							   _detail::json_string(result.name), result.iterations, result.samples, result.outliers);
+			for (const auto& [key, field] : _detail::result_fields)
+				out << std::format(", \"{}\": {}", key, _detail::json_number(result.*field));
+
+			out << ", \"samples_ns\": [";
+			for (size_t i = 0; i < result.samples_ns.size(); ++i)
+				out << std::format("{}{}", i ? ", " : "", _detail::json_number(result.samples_ns[i]));
+			out << "]}";
+			first = false;
+		}
+		out << "\n  ]\n}\n";
+	}
+
+	// one header line and one row per result, the metadata repeated in trailing columns of every row;
+	// raw samples are left out
+	inline void write_csv(std::ostream& out, const Report& report)
+	{
+		out << "name,iterations,samples,outliers";
+		for (const auto& [key, field] : _detail::result_fields)
+			out << ',' << key;
+		for (const auto& [key, field] : _detail::metadata_fields)
+			out << ',' << key;
+		out << '\n';
+
+		std::string metadata;
+		for (const auto& [key, field] : _detail::metadata_fields)
+			(metadata += ',') += _detail::csv_field(report.metadata.*field);
+
+		for (const Result& result : report.results)
+		{
+			out << std::format("{},{},{},{}", _detail::csv_field(result.name), result.iterations, result.samples, result.outliers);
+			for (const auto& [key, field] : _detail::result_fields)
+				out << std::format(",{}", result.*field);
+			out << metadata << '\n';
+		}
+	}
+
+	[[nodiscard]] inline Report read_json(std::istream& in)
+	{
+		_detail::JsonReader reader(std::string(std::istreambuf_iterator<char>(in), {}));
+		Report				report{.metadata = {}, .results = {}};
+
+		reader.object([&](const std::string& key) {
+			if (key == "metadata")
+			{
+				reader.object([&](const std::string& name) {
+					const auto it = std::ranges::find(_detail::metadata_fields, name, [](const auto& field) { return field.first; });
+					if (it != _detail::metadata_fields.end())
+						report.metadata.*it->second = reader.string();
+					else
+						reader.skip_value();
+				});
+			}
+			else if (key == "results")
+			{
+				reader.array([&] {
+					Result& result = report.results.emplace_back();
+					reader.object([&](const std::string& name) {
+						const auto it = std::ranges::find(_detail::result_fields, name, [](const auto& field) { return field.first; });
+						if (name == "name")
+							result.name = reader.string();
+						else if (name == "iterations")
+							result.iterations = reader.integer<uint64_t>();
+						else if (name == "samples")
+							result.samples = reader.integer<size_t>();
+						else if (name == "outliers")
+							result.outliers = reader.integer<size_t>();
+						else if (name == "samples_ns")
+							reader.array([&] { result.samples_ns.push_back(reader.number()); });
+						else if (it != _detail::result_fields.end())
+							result.*it->second = reader.number();
+						else
+							reader.skip_value();
+					});
+				});
+			}
+			else
+				reader.skip_value();
+		});
+		return report;
+	}
+
+	inline bool save_json(const std::string& path, const Report& report)
+	{
+		std::ofstream out(path);
+		write_json(out, report);
+		return static_cast<bool>(out);
+	}
+
+	inline bool save_csv(const std::string& path, const Report& report)
+	{
+		std::ofstream out(path);
+		write_csv(out, report);
+		return static_cast<bool>(out);
+	}
+
+	// throws std::runtime_error if the file can't be opened or parsed
+	[[nodiscard]] inline Report load_json(const std::string& path)
+	{
+		std::ifstream in(path);
+		if (!in)
+			throw std::runtime_error(std::format("Bench: can't open {}", path));
+		return read_json(in);
+	}
+
+	struct Comparison
+	{
+		std::string name;
+		double		baseline_ns = 0;
+		double		current_ns	= 0;
+		double		change		= 0; // relative, positive when slower
+		double		statistic	= 0; // Mann-Whitney z or Welch t, positive when slower
+		bool		significant = false;
+		bool		regression	= false;
+		bool		improvement = false;
+	};
+
+	namespace _detail
+	{
+		// normal approximation of the Mann-Whitney U test with tie correction, significant at 95% two-sided
+		[[nodiscard]] inline std::pair<double, bool> mann_whitney(const std::vector<double>& baseline, const std::vector<double>& current)
+		{
+			std::vector<std::pair<double, bool>> pooled;
+			pooled.reserve(baseline.size() + current.size());
+			for (const double ns : baseline)
+				pooled.emplace_back(ns, false);
+			for (const double ns : current)
+				pooled.emplace_back(ns, true);
+			std::ranges::sort(pooled, {}, &std::pair<double, bool>::first);
+
+			const double n		   = static_cast<double>(pooled.size());
+			double		 rank_sum  = 0;
+			double		 tie_terms = 0;
+			for (size_t i = 0; i < pooled.size();)
+			{
+				size_t j = i;
+				while (j < pooled.size() && pooled[j].first == pooled[i].first)
+					++j;
+
+				const double ties = static_cast<double>(j - i);
+				const double rank = static_cast<double>(i + j + 1) / 2.0;
+				for (size_t k = i; k < j; ++k)
+					rank_sum += pooled[k].second ? rank : 0.0;
+				tie_terms += ties * ties * ties - ties;
+				i = j;
+			}
+
+			const double n1		= static_cast<double>(current.size());
+			const double n2		= static_cast<double>(baseline.size());
+			const double u		= rank_sum - n1 * (n1 + 1) / 2;
+			const double sigma2 = n1 * n2 / 12.0 * ((n + 1) - tie_terms / (n * (n - 1)));
+			const double z		= sigma2 > 0 ? (u - n1 * n2 / 2) / std::sqrt(sigma2) : 0.0;
+			return {z, std::abs(z) > 1.96};
+		}
+
+		// Welch's t test on the summaries, for results exported without raw samples
+		[[nodiscard]] inline std::pair<double, bool> welch(const Result& baseline, const Result& current)
+		{
+			const double n1 = static_cast<double>(current.samples);
+			const double n2 = static_cast<double>(baseline.samples);
+			if (n1 < 2 || n2 < 2)
+				return {0.0, false};
+
+			const double v1 = current.stddev_ns * current.stddev_ns / n1;
+			const double v2 = baseline.stddev_ns * baseline.stddev_ns / n2;
+			if (v1 + v2 <= 0)
+				return {0.0, current.ns_per_op != baseline.ns_per_op};
+
+			const double t		 = (current.ns_per_op - baseline.ns_per_op) / std::sqrt(v1 + v2);
+			const double degrees = (v1 + v2) * (v1 + v2) / (v1 * v1 / (n1 - 1) + v2 * v2 / (n2 - 1));
+			return {t, std::abs(t) > t_quantile(static_cast<size_t>(std::max(degrees, 1.0)))};
+		}
+	} // namespace _detail
+
+	// pairs results by name; a change counts only when it is both significant and larger than `threshold`
+	[[nodiscard]] inline std::vector<Comparison> compare(const Report& baseline, const Report& current, double threshold = 0.05)
+	{
+		std::vector<Comparison> comparisons;
+		for (const Result& now : current.results)
+		{
+			const auto before = std::ranges::find(baseline.results, now.name, &Result::name);
+			if (before == baseline.results.end())
+				continue;
+
+			// medians when both sides kept their samples, means otherwise
+			const bool	with_samples = before->samples_ns.size() > 1 && now.samples_ns.size() > 1;
+			Comparison& comparison	 = comparisons.emplace_back();
+			comparison.name			 = now.name;
+			comparison.baseline_ns	 = with_samples ? before->median_ns : before->ns_per_op;
+			comparison.current_ns	 = with_samples ? now.median_ns : now.ns_per_op;
+			comparison.change		 = comparison.baseline_ns > 0 ? comparison.current_ns / comparison.baseline_ns - 1 : 0.0;
+
+			std::tie(comparison.statistic, comparison.significant) =
+				with_samples ? _detail::mann_whitney(before->samples_ns, now.samples_ns) : _detail::welch(*before, now);
+			comparison.regression  = comparison.significant && comparison.change > threshold;
+			comparison.improvement = comparison.significant && comparison.change < -threshold;
+		}
+		return comparisons;
+	}
+
+	// prints one line per comparison and returns the process exit status: 1 if anything regressed
+	inline int report_regressions(const std::vector<Comparison>& comparisons, std::ostream& out)
+	{
+		int status = 0;
+		for (const Comparison& comparison : comparisons)
+		{
+			const std::string_view verdict = comparison.regression ? "REGRESSION" : comparison.improvement ? "improved" : "unchanged";
+			out << std::format("{:<10} {}: {:.3f} -> {:.3f} ns ({:+.1f}%, statistic {:.2f})\n", verdict, comparison.name,
+							   comparison.baseline_ns, comparison.current_ns, comparison.change * 100, comparison.statistic);
+			status |= comparison.regression ? 1 : 0;
+		}
+		return status;
+	}
+
+	// the whole check for a build step: 0 when nothing regressed, 1 on a regression, 2 without a usable baseline
+	inline int check_baseline(const std::string& baseline_path, const Report& current, std::ostream& out, double threshold = 0.05)
+	{
+		try
+		{
+			return report_regressions(compare(load_json(baseline_path), current, threshold), out);
+		}
+		catch (const std::runtime_error& error)
+		{
+			out << error.what() << '\n';
+			return 2;
+		}
+	}
+} // namespace Bench
@@ -0,0 +1,369 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <format>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "timer.hpp"
+
+#ifndef PROFILER_ENABLED
+	#ifdef NDEBUG
+		#define PROFILER_ENABLED 0
+	#else
+		#define PROFILER_ENABLED 1
+	#endif
+#endif
+
+// events kept per thread, later ones are dropped and counted (see Profiler::dropped_events)
+#ifndef PROFILER_MAX_EVENTS
+	#define PROFILER_MAX_EVENTS (size_t{1} << 20)
+#endif
+
+#define PROFILER_CONCAT_IMPL(a, b) a##b
+#define PROFILER_CONCAT(a, b)	   PROFILER_CONCAT_IMPL(a, b)
+
+#if PROFILER_ENABLED
+	// times the enclosing scope; `name` must outlive the profiler (a string literal)
+	#define PROFILE_SCOPE(name) const Profiler::Scope PROFILER_CONCAT(_profile_scope_, __LINE__)(name)
+	#define PROFILE_FUNCTION()	PROFILE_SCOPE(__func__)
+#else
+	#define PROFILE_SCOPE(name) ((void)0)
+	#define PROFILE_FUNCTION()	((void)0)
+#endif
+
+namespace Profiler
+{
+	struct Event
+	{
+		const char* name;
+		uint64_t	begin;
+		uint64_t	end;
+		uint32_t	depth;
+	};
+
+	struct CallNode
+	{
+		std::string_view		 name;
+		uint64_t				 calls = 0;
+		std::chrono::nanoseconds inclusive{};
+		std::chrono::nanoseconds exclusive{};
+		std::vector<CallNode>	 children{};
+
+		[[nodiscard]] CallNode& child(std::string_view child_name)
+		{
+			const auto it = std::ranges::find(children, child_name, &CallNode::name);
+			return it != children.end() ? *it : children.emplace_back(CallNode{.name = child_name});
+		}
+	};
+
+	namespace _detail
+	{
+		// single-writer event log: the owning thread appends, readers see every event up to the published size
+		class ThreadBuffer
+		{
+			static constexpr size_t chunk_events = 4096;
+			static constexpr size_t max_chunks	 = std::max<size_t>((PROFILER_MAX_EVENTS + chunk_events - 1) / chunk_events, 1);
+
+			struct Chunk
+			{
+				std::array<Event, chunk_events> events;
+				std::atomic<size_t>				size = 0;
+				std::atomic<Chunk*>				next = nullptr;
+			};
+
+		  public:
+			ThreadBuffer(uint32_t id, std::string name, uint64_t generation)
+				: m_id(id), m_name(std::move(name)), m_generation(generation), m_head(new Chunk), m_tail(m_head)
+			{
+			}
+
+			~ThreadBuffer()
+			{
+				for (Chunk* chunk = m_head; chunk;)
+					delete std::exchange(chunk, chunk->next.load(std::memory_order_relaxed));
+			}
+
+			ThreadBuffer(const ThreadBuffer&)			 = delete;
+			ThreadBuffer& operator=(const ThreadBuffer&) = delete;
+
+			// never allocates past the cap and never throws, the event is dropped instead
+			void push(const Event& event) noexcept
+			{
+				size_t size = m_tail->size.load(std::memory_order_relaxed);
+				if (size == chunk_events) [[unlikely]]
+				{
+					Chunk* const chunk = m_chunks < max_chunks ? new (std::nothrow) Chunk : nullptr;
+					if (!chunk)
+					{
+						m_dropped.store(m_dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+						return;
+					}
+					++m_chunks;
+					m_tail->next.store(chunk, std::memory_order_release);
+					m_tail = chunk;
+					size   = 0;
+				}
+				m_tail->events[size] = event;
+				m_tail->size.store(size + 1, std::memory_order_release);
+			}
+
+			void for_each(auto&& func) const
+			{
+				for (const Chunk* chunk = m_head; chunk; chunk = chunk->next.load(std::memory_order_acquire))
+				{
+					const size_t size = chunk->size.load(std::memory_order_acquire);
+					for (size_t i = 0; i < size; ++i)
+						func(chunk->events[i]);
+				}
+			}
+
+			[[nodiscard]] uint32_t id() const noexcept
+			{
+				return m_id;
+			}
+
+			[[nodiscard]] const std::string& name() const noexcept
+			{
+				return m_name;
+			}
+
+			// the Registry generation the buffer was registered in
+			[[nodiscard]] uint64_t generation() const noexcept
+			{
+				return m_generation;
+			}
+
+			[[nodiscard]] uint64_t dropped() const noexcept
+			{
+				return m_dropped.load(std::memory_order_relaxed);
+			}
+
+			uint32_t depth = 0;
+
+		  private:
+			uint32_t			  m_id;
+			std::string			  m_name;
+			uint64_t			  m_generation;
+			Chunk*				  m_head;
+			Chunk*				  m_tail;
+			size_t				  m_chunks	= 1;
+			std::atomic<uint64_t> m_dropped = 0;
+		};
+
+		class Registry
+		{
+		  public:
+			[[nodiscard]] static Registry& instance()
+			{
+				static Registry registry;
+				return registry;
+			}
+
+			struct Snapshot
+			{
+				uint64_t								   epoch;
+				std::vector<std::shared_ptr<ThreadBuffer>> threads;
+			};
+
+			[[nodiscard]] std::shared_ptr<ThreadBuffer> add_thread(std::string name)
+			{
+				std::scoped_lock lock(m_mutex);
+				const auto		 id = static_cast<uint32_t>(m_buffers.size() + 1);
+				return m_buffers.emplace_back(std::make_shared<ThreadBuffer>(id, name.empty() ? std::format("thread {}", id) : std::move(name),
+																			 m_generation.load(std::memory_order_relaxed)));
+			}
+
+			[[nodiscard]] std::vector<std::shared_ptr<ThreadBuffer>> threads() const
+			{
+				std::scoped_lock lock(m_mutex);
+				return m_buffers;
+			}
+
+			[[nodiscard]] Snapshot snapshot() const
+			{
+				std::scoped_lock lock(m_mutex);
+				return {m_epoch, m_buffers};
+			}
+
+			// forgets every buffer and restarts the clock; the buffers stay alive as long as their thread holds them
+			void clear()
+			{
+				std::scoped_lock lock(m_mutex);
+				m_buffers.clear();
+				m_epoch = TscClock::ticks();
+				m_generation.fetch_add(1, std::memory_order_relaxed);
+			}
+
+			[[nodiscard]] uint64_t generation() const noexcept
+			{
+				return m_generation.load(std::memory_order_relaxed);
+			}
+
+		  private:
+			mutable std::mutex						   m_mutex;
+			std::vector<std::shared_ptr<ThreadBuffer>> m_buffers;
+			uint64_t								   m_epoch = TscClock::ticks();
+			std::atomic<uint64_t>					   m_generation = 0;
+		};
+
+		inline thread_local std::string thread_name;
+
+		[[nodiscard]] inline ThreadBuffer& this_thread()
+		{
+			// shared with the registry, so the events outlive the thread; after a clear() the buffer is swapped
+			// only once no scope of this thread is open, so an open scope never loses its buffer
+			thread_local std::shared_ptr<ThreadBuffer> buffer;
+			if (!buffer || (buffer->depth == 0 && buffer->generation() != Registry::instance().generation())) [[unlikely]]
+				buffer = Registry::instance().add_thread(thread_name);
+			return *buffer;
+		}
+
+		inline void write_json_string(std::ostream& out, std::string_view text)
+		{
+			out << '"';
+			for (const char c : text)
+			{
+				if (c == '"' || c == '\\')
+					out << '\\' << c;
+				else if (static_cast<unsigned char>(c) < 0x20)
+					out << std::format("\\u{:04x}", static_cast<unsigned>(c));
+				else
+					out << c;
+			}
+			out << '"';
+		}
+	} // namespace _detail
+
+	// names the calling thread in exports; takes effect if called before its first profiled scope
+	inline void set_thread_name(std::string name)
+	{
+		_detail::thread_name = std::move(name);
+	}
+
+	// drops every recorded event; scopes open during the call are not recorded
+	inline void clear()
+	{
+		_detail::Registry::instance().clear();
+	}
+
+	// events not recorded because their thread already held PROFILER_MAX_EVENTS
+	[[nodiscard]] inline uint64_t dropped_events()
+	{
+		uint64_t dropped = 0;
+		for (const auto& thread : _detail::Registry::instance().threads())
+			dropped += thread->dropped();
+		return dropped;
+	}
+
+	class Scope
+	{
+	  public:
+		// registers the thread on its first scope, which allocates and may throw
+		explicit Scope(const char* name)
+			: m_buffer(_detail::this_thread()), m_name(name), m_depth(m_buffer.depth++), m_begin(TscClock::ticks())
+		{
+		}
+
+		~Scope()
+		{
+			const uint64_t end = TscClock::ticks();
+			--m_buffer.depth;
+			m_buffer.push({m_name, m_begin, end, m_depth});
+		}
+
+		Scope(const Scope&)			   = delete;
+		Scope& operator=(const Scope&) = delete;
+
+	  private:
+		_detail::ThreadBuffer& m_buffer;
+		const char*			   m_name;
+		uint32_t			   m_depth;
+		uint64_t			   m_begin;
+	};
+
+	// merges the scopes of all threads into one tree keyed by call path
+	[[nodiscard]] inline CallNode build_call_tree()
+	{
+		CallNode root{.name = "<root>"};
+
+		for (const auto& thread : _detail::Registry::instance().threads())
+		{
+			std::vector<Event> events;
+			thread->for_each([&](const Event& event) { events.push_back(event); });
+			std::ranges::sort(events, [](const Event& a, const Event& b) { return a.begin != b.begin ? a.begin < b.begin : a.depth < b.depth; });
+
+			std::vector<std::pair<CallNode*, const Event*>> stack;
+			for (const Event& event : events)
+			{
+				// the parent is the latest open scope one level up
+				while (!stack.empty() && stack.back().second->depth >= event.depth)
+					stack.pop_back();
+
+				CallNode&  parent	  = stack.empty() ? root : *stack.back().first;
+				CallNode&  node		  = parent.child(event.name);
+				const auto inclusive = TscClock::to_duration(event.end - event.begin);
+
+				++node.calls;
+				node.inclusive += inclusive;
+				node.exclusive += inclusive;
+				if (!stack.empty())
+					parent.exclusive -= inclusive;
+
+				stack.emplace_back(&node, &event);
+			}
+		}
+
+		for (const CallNode& child : root.children)
+		{
+			root.calls += child.calls;
+			root.inclusive += child.inclusive;
+		}
+		return root;
+	}
+
+	// Chrome Trace Event format, loadable in chrome://tracing and ui.perfetto.dev
+	inline void write_chrome_trace(std::ostream& out)
+	{
+		const auto [epoch, threads] = _detail::Registry::instance().snapshot();
+		const auto micros		    = [](uint64_t ticks) {
+			return std::chrono::duration<double, std::micro>(TscClock::to_duration(ticks)).count();
+		};
+
+		out << "{\"traceEvents\":[";
+		bool first = true;
+		for (const auto& thread : threads)
+		{
+			out << (first ? "\n" : ",\n") << std::format(R"({{"name":"thread_name","ph":"M","pid":1,"tid":{},"args":{{"name":)", thread->id());
+			_detail::write_json_string(out, thread->name());
+			out << "}}";
+			first = false;
+
+			thread->for_each([&](const Event& event) {
+				out << ",\n{\"name\":";
+				_detail::write_json_string(out, event.name);
+				out << std::format(R"(,"ph":"X","pid":1,"tid":{},"ts":{:.3f},"dur":{:.3f}}})", thread->id(),
+								   micros(event.begin - epoch), micros(event.end - event.begin));
+			});
+		}
+		out << "\n],\"displayTimeUnit\":\"ns\"}\n";
+	}
+
+	inline bool save_chrome_trace(const std::string& path)
+	{
+		std::ofstream out(path);
+		write_chrome_trace(out);
+		return static_cast<bool>(out);
+	}
+} // namespace Profiler
@@ -1,20 +1,36 @@
 ﻿#pragma once
 
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cctype>
+#include <cmath>
 #include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <execution>
 #include <functional>
 #include <limits>
+#include <numeric>
 #include <random>
 #include <ranges>
+#include <span>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
+#if defined(_MSC_VER) && defined(_M_X64) && !defined(__SIZEOF_INT128__)
+	#include <intrin.h>
+#endif
+
 #ifdef RANDOM_STATIC
 	#define AUTO_SIGNATURE inline static auto
-	#define VARIABLE_TYPE  static inline thread_local
 #else
 	#define AUTO_SIGNATURE inline auto
-	#define VARIABLE_TYPE
 #endif
 
 namespace API_Random
@@ -35,7 +51,7 @@ namespace API_Random
 	template<typename T>
 	concept IsStringoid = std::is_convertible_v<T, std::string_view>;
 
-	using StringGenPredicate = std::function<decltype(isalnum)>;
+	using StringGenPredicate = std::function<int(int)>;
 
 	/**
 	 * @brief Concept that checks if the type is suitable for generating string
@@ -45,6 +61,2392 @@ namespace API_Random
 	 */
 	template<typename T>
 	concept StringGeneraionType = IsStringoid<T> || std::is_convertible_v<T, StringGenPredicate>;
+
+	/**
+	 * @brief Multiply two 64-bit words into a 128-bit product
+	 *
+	 * @param a The first factor
+	 * @param b The second factor
+	 * @param lo Receives the low 64 bits of the product
+	 * @return The high 64 bits of the product
+	 */
+	[[nodiscard]] constexpr uint64_t mul_64x64(uint64_t a, uint64_t b, uint64_t& lo) noexcept
+	{
+#if defined(__SIZEOF_INT128__)
+		const auto product = static_cast<unsigned __int128>(a) * b;
+		lo = static_cast<uint64_t>(product);
+		return static_cast<uint64_t>(product >> 64);
+#else
+	#if defined(_MSC_VER) && defined(_M_X64)
+		if (not std::is_constant_evaluated())
+		{
+			uint64_t hi;
+			lo = _umul128(a, b, &hi);
+			return hi;
+		}
+	#endif
+		const uint64_t a_lo = a & 0xFFFFFFFF, a_hi = a >> 32;
+		const uint64_t b_lo = b & 0xFFFFFFFF, b_hi = b >> 32;
+
+		const uint64_t lo_lo = a_lo * b_lo;
+		const uint64_t hi_lo = a_hi * b_lo;
+		const uint64_t lo_hi = a_lo * b_hi;
+		const uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFF) + lo_hi;
+
+		lo = (cross << 32) | (lo_lo & 0xFFFFFFFF);
+		return a_hi * b_hi + (hi_lo >> 32) + (cross >> 32);
+#endif
+	}
+
+	/**
+	 * @brief Draw a uniformly distributed unsigned word from an engine
+	 *
+	 * Engines with a power-of-two range are concatenated directly; all other engines
+	 * (e.g. `std::minstd_rand`) go through the algorithm specified for `std::independent_bits_engine`,
+	 * so the result is bit-exact on every standard library for a given engine state
+	 *
+	 * @tparam UInt The unsigned type to fill with random bits
+	 * @param engine The engine to draw from
+	 * @return A random value covering the whole range of UInt
+	 */
+	template<std::unsigned_integral UInt, std::uniform_random_bit_generator Engine>
+	[[nodiscard]] constexpr UInt uniform_bits(Engine& engine)
+	{
+		constexpr int word_bits = std::numeric_limits<UInt>::digits;
+		constexpr uint64_t range_m1 = static_cast<uint64_t>(Engine::max() - Engine::min());
+
+		if constexpr (std::has_single_bit(range_m1 + 1) or range_m1 == std::numeric_limits<uint64_t>::max())
+		{
+			constexpr int engine_bits = std::bit_width(range_m1);
+			if constexpr (engine_bits >= word_bits)
+			{
+				return static_cast<UInt>(engine() - Engine::min());
+			}
+			else
+			{
+				UInt result = 0;
+				for (int filled = 0; filled < word_bits; filled += engine_bits)
+				{
+					result = static_cast<UInt>((result << engine_bits) | static_cast<UInt>(engine() - Engine::min()));
+				}
+				return result;
+			}
+		}
+		else
+		{
+			constexpr uint64_t range = range_m1 + 1;
+			constexpr int log2_range = std::bit_width(range) - 1;
+
+			constexpr auto chunks = [] {
+				int n = (word_bits + log2_range - 1) / log2_range;
+				if (const int w0 = word_bits / n; range - ((range >> w0) << w0) > ((range >> w0) << w0) / n)
+				{
+					++n;
+				}
+				return n;
+			}();
+			constexpr int w0 = word_bits / chunks;
+			constexpr int n0 = chunks - word_bits % chunks;
+			constexpr uint64_t y0 = (range >> w0) << w0;
+			constexpr uint64_t y1 = (range >> (w0 + 1)) << (w0 + 1);
+
+			UInt result = 0;
+			for (int k = 0; k < chunks; ++k)
+			{
+				const int bits = k < n0 ? w0 : w0 + 1;
+				const uint64_t limit = k < n0 ? y0 : y1;
+
+				uint64_t u;
+				do
+				{
+					u = static_cast<uint64_t>(engine() - Engine::min());
+				}
+				while (u >= limit);
+
+				result = static_cast<UInt>((static_cast<uint64_t>(result) << bits) | (u & ((uint64_t { 1 } << bits) - 1)));
+			}
+			return result;
+		}
+	}
+
+	/**
+	 * @brief Generate a uniformly distributed value in `[0, bound)` with Lemire's multiply-shift method
+	 *
+	 * A single multiplication maps a random word onto the range; a division is only needed
+	 * in the rare case where the low half of the product falls into the biased zone
+	 *
+	 * @tparam UInt The word type used for generation (uint32_t or uint64_t)
+	 * @param engine The engine to draw from
+	 * @param bound The exclusive upper bound (must be non-zero)
+	 * @return A random value in `[0, bound)`
+	 */
+	template<std::unsigned_integral UInt, std::uniform_random_bit_generator Engine>
+		requires(sizeof(UInt) == 4 or sizeof(UInt) == 8)
+	[[nodiscard]] constexpr UInt bounded(Engine& engine, UInt bound)
+	{
+		if constexpr (sizeof(UInt) == 4)
+		{
+			uint64_t product = uint64_t { uniform_bits<uint32_t>(engine) } * bound;
+			if (auto low = static_cast<uint32_t>(product); low < bound) [[unlikely]]
+			{
+				const uint32_t threshold = static_cast<uint32_t>(-bound) % bound;
+				while (low < threshold)
+				{
+					product = uint64_t { uniform_bits<uint32_t>(engine) } * bound;
+					low = static_cast<uint32_t>(product);
+				}
+			}
+			return static_cast<uint32_t>(product >> 32);
+		}
+		else
+		{
+			uint64_t low;
+			uint64_t high = mul_64x64(uniform_bits<uint64_t>(engine), bound, low);
+			if (low < bound) [[unlikely]]
+			{
+				const uint64_t threshold = (0 - bound) % bound;
+				while (low < threshold)
+				{
+					high = mul_64x64(uniform_bits<uint64_t>(engine), bound, low);
+				}
+			}
+			return high;
+		}
+	}
+
+	/**
+	 * @brief Generate a uniformly distributed integer in `[min_val, max_val]`
+	 *
+	 * @note The bounds are swapped when given in reverse order
+	 * @tparam Int The integral type of the result
+	 * @param engine The engine to draw from
+	 * @param min_val The minimum value (inclusive)
+	 * @param max_val The maximum value (inclusive)
+	 * @return A random value in selected range
+	 */
+	template<std::integral Int, std::uniform_random_bit_generator Engine>
+	[[nodiscard]] constexpr Int bounded_in_range(Engine& engine, Int min_val, Int max_val)
+	{
+		if constexpr (std::same_as<Int, bool>)
+		{
+			return min_val == max_val ? min_val : static_cast<bool>(uniform_bits<uint32_t>(engine) >> 31);
+		}
+		else
+		{
+			using UInt = std::make_unsigned_t<Int>;
+			using Word = std::conditional_t<sizeof(Int) <= 4, uint32_t, uint64_t>;
+
+			if (max_val < min_val)
+			{
+				std::swap(min_val, max_val);
+			}
+
+			const Word span = static_cast<Word>(static_cast<UInt>(static_cast<UInt>(max_val) - static_cast<UInt>(min_val)));
+			const Word offset = span == std::numeric_limits<Word>::max() ? uniform_bits<Word>(engine) : bounded<Word>(engine, span + 1);
+
+			return static_cast<Int>(static_cast<UInt>(static_cast<UInt>(min_val) + static_cast<UInt>(offset)));
+		}
+	}
+
+	/**
+	 * @brief Generate a uniformly distributed double in the open interval `(0, 1)`
+	 *
+	 * @param engine The engine to draw from
+	 * @return A random value built from 53 random bits, never exactly 0 or 1
+	 */
+	template<std::uniform_random_bit_generator Engine>
+	[[nodiscard]] constexpr double uniform_open01(Engine& engine)
+	{
+		return (static_cast<double>(uniform_bits<uint64_t>(engine) >> 11) + 0.5) * 0x1.0p-53;
+	}
+
+	/**
+	 * @brief Generate a uniformly distributed floating-point value in `[0, 1)` directly from random bits
+	 *
+	 * The top `digits` bits of one word (24 for float, 53 for double) are scaled by 2^-digits,
+	 * so every result is an exact multiple of 2^-digits and 1 is never returned
+	 *
+	 * @tparam Real The floating-point type of the result
+	 * @param engine The engine to draw from
+	 * @return A random value in `[0, 1)`
+	 */
+	template<std::floating_point Real, std::uniform_random_bit_generator Engine>
+	[[nodiscard]] constexpr Real canonical(Engine& engine)
+	{
+		constexpr int bits = std::min(std::numeric_limits<Real>::digits, 64);
+		using Word = std::conditional_t<bits <= 32, uint32_t, uint64_t>;
+
+		constexpr Real scale = [] {
+			Real value = 1;
+			for (int i = 0; i < bits; ++i)
+			{
+				value /= 2;
+			}
+			return value;
+		}();
+
+		return static_cast<Real>(uniform_bits<Word>(engine) >> (std::numeric_limits<Word>::digits - bits)) * scale;
+	}
+
+	/**
+	 * @brief Map a `[0, 1)` value onto `[min_val, max_val)`
+	 *
+	 * @note Bounds given in reverse order are swapped; spans that overflow (e.g. `lowest()` to `max()`)
+	 * are interpolated without overflow; rounding never produces `max_val` unless `min_val == max_val`
+	 */
+	template<std::floating_point Real>
+	[[nodiscard]] constexpr Real scale_unit(Real unit, Real min_val, Real max_val) noexcept
+	{
+		if (max_val < min_val)
+		{
+			std::swap(min_val, max_val);
+		}
+
+		const Real span = max_val - min_val;
+		const Real value = span <= std::numeric_limits<Real>::max() ? min_val + unit * span : (1 - unit) * min_val + unit * max_val;
+
+		return value < max_val ? std::max(value, min_val) : (min_val == max_val ? min_val : std::nextafter(max_val, min_val));
+	}
+
+	/**
+	 * @brief Generate a uniformly distributed floating-point value in `[min_val, max_val)`
+	 *
+	 * @param engine The engine to draw from
+	 * @param min_val The minimum value (inclusive)
+	 * @param max_val The maximum value (exclusive)
+	 * @return A random value in selected range, see `scale_unit` for the edge cases
+	 */
+	template<std::floating_point Real, std::uniform_random_bit_generator Engine>
+	[[nodiscard]] constexpr Real uniform_real(Engine& engine, Real min_val, Real max_val)
+	{
+		return scale_unit(canonical<Real>(engine), min_val, max_val);
+	}
+
+	/**
+	 * @brief Fill a buffer with uniformly distributed floating-point values in `[min_val, max_val)`
+	 *
+	 * The generated values equal consecutive `uniform_real` calls; the range checks are hoisted out of the loop
+	 *
+	 * @param engine The engine to draw from
+	 * @param out The buffer to fill
+	 * @param min_val The minimum value (inclusive)
+	 * @param max_val The maximum value (exclusive)
+	 */
+	template<std::floating_point Real, std::uniform_random_bit_generator Engine>
+	constexpr void fill_uniform_real(Engine& engine, std::span<Real> out, Real min_val, Real max_val)
+	{
+		if (max_val < min_val)
+		{
+			std::swap(min_val, max_val);
+		}
+
+		if (const Real span = max_val - min_val; span <= std::numeric_limits<Real>::max() and min_val < max_val)
+		{
+			const Real below_max = std::nextafter(max_val, min_val);
+			for (Real& value : out)
+			{
+				value = std::clamp(min_val + canonical<Real>(engine) * span, min_val, below_max);
+			}
+		}
+		else
+		{
+			for (Real& value : out)
+			{
+				value = uniform_real(engine, min_val, max_val);
+			}
+		}
+	}
+
+	namespace _detail
+	{
+		/**
+		 * @brief Layer boundaries of a ziggurat (Marsaglia & Tsang), laid out as in Doornik's ZIGNOR
+		 *
+		 * `x[0]` is the width of the base strip, `x[1]` the tail start and `x[Layers]` is 0;
+		 * `ratio[i] = x[i + 1] / x[i]` is the fast acceptance bound and `f[i]` the density at `x[i]`
+		 */
+		template<size_t Layers>
+		struct ZigguratTable
+		{
+			std::array<double, Layers + 1> x;
+			std::array<double, Layers + 1> f;
+			std::array<double, Layers> ratio;
+		};
+
+		template<size_t Layers>
+		[[nodiscard]] ZigguratTable<Layers> make_ziggurat(double tail, double area, auto&& density, auto&& inverse)
+		{
+			ZigguratTable<Layers> table;
+
+			table.x[0] = area / density(tail);
+			table.x[1] = tail;
+			for (size_t i = 2; i < Layers; ++i)
+			{
+				table.x[i] = inverse(area / table.x[i - 1] + density(table.x[i - 1]));
+			}
+			table.x[Layers] = 0;
+
+			for (size_t i = 0; i <= Layers; ++i)
+			{
+				table.f[i] = density(table.x[i]);
+			}
+			for (size_t i = 0; i < Layers; ++i)
+			{
+				table.ratio[i] = table.x[i + 1] / table.x[i];
+			}
+			return table;
+		}
+
+		inline constexpr double normal_tail = 3.442619855899;
+		inline constexpr double exponential_tail = 7.69711747013104972;
+
+		[[nodiscard]] inline const ZigguratTable<128>& normal_table()
+		{
+			static const auto table = make_ziggurat<128>(
+				normal_tail, 9.91256303526217e-3, [](double x) { return std::exp(-0.5 * x * x); },
+				[](double y) { return std::sqrt(-2 * std::log(y)); });
+			return table;
+		}
+
+		[[nodiscard]] inline const ZigguratTable<256>& exponential_table()
+		{
+			static const auto table = make_ziggurat<256>(
+				exponential_tail, 3.949659822581572e-3, [](double x) { return std::exp(-x); },
+				[](double y) { return -std::log(y); });
+			return table;
+		}
+
+		/**
+		 * @brief Finish a standard normal draw that starts from `word`, drawing more words on rejection
+		 */
+		template<std::uniform_random_bit_generator Engine>
+		[[nodiscard]] double normal_from(Engine& engine, uint64_t word)
+		{
+			const auto& table = normal_table();
+			for (;;)
+			{
+				const size_t i = word & 127;
+				const double u = static_cast<double>(word >> 11) * 0x1.0p-52 - 1;
+				if (std::abs(u) < table.ratio[i])
+				{
+					return u * table.x[i];
+				}
+
+				if (i == 0)
+				{
+					double x, y;
+					do
+					{
+						x = std::log(uniform_open01(engine)) / normal_tail;
+						y = std::log(uniform_open01(engine));
+					}
+					while (-2 * y < x * x);
+
+					return u < 0 ? x - normal_tail : normal_tail - x;
+				}
+
+				const double x = u * table.x[i];
+				if (table.f[i + 1] + canonical<double>(engine) * (table.f[i] - table.f[i + 1]) < std::exp(-0.5 * x * x))
+				{
+					return x;
+				}
+				word = uniform_bits<uint64_t>(engine);
+			}
+		}
+
+		/**
+		 * @brief Finish a standard exponential draw that starts from `word`, drawing more words on rejection
+		 */
+		template<std::uniform_random_bit_generator Engine>
+		[[nodiscard]] double exponential_from(Engine& engine, uint64_t word)
+		{
+			const auto& table = exponential_table();
+			for (;;)
+			{
+				const size_t i = word & 255;
+				const double u = static_cast<double>(word >> 11) * 0x1.0p-53;
+				if (u < table.ratio[i])
+				{
+					return u * table.x[i];
+				}
+
+				if (i == 0)
+				{
+					return exponential_tail - std::log(uniform_open01(engine));
+				}
+
+				const double x = u * table.x[i];
+				if (table.f[i + 1] + canonical<double>(engine) * (table.f[i] - table.f[i + 1]) < std::exp(-x))
+				{
+					return x;
+				}
+				word = uniform_bits<uint64_t>(engine);
+			}
+		}
+
+		/**
+		 * @brief Blocked bulk ziggurat: the engine loop, the branch-free fast path and the rare
+		 * rejections run as three separate passes, so the fast path can be vectorized
+		 */
+		template<bool Symmetric, size_t Layers, std::floating_point Real, std::uniform_random_bit_generator Engine>
+		void fill_ziggurat(Engine& engine, std::span<Real> out, const ZigguratTable<Layers>& table, Real shift, Real scale, auto&& resolve)
+		{
+			constexpr size_t block_size = 256;
+
+			std::array<uint64_t, block_size> words;
+			std::array<uint8_t, block_size> rejected;
+
+			for (size_t offset = 0; offset < out.size(); offset += block_size)
+			{
+				const size_t count = std::min(block_size, out.size() - offset);
+				Real* const dst = out.data() + offset;
+
+				for (size_t i = 0; i < count; ++i)
+				{
+					words[i] = uniform_bits<uint64_t>(engine);
+				}
+
+				for (size_t i = 0; i < count; ++i)
+				{
+					const size_t layer = words[i] & (Layers - 1);
+					const double u = Symmetric ? static_cast<double>(words[i] >> 11) * 0x1.0p-52 - 1 : static_cast<double>(words[i] >> 11) * 0x1.0p-53;
+
+					dst[i] = static_cast<Real>(shift + scale * (u * table.x[layer]));
+					rejected[i] = (Symmetric ? std::abs(u) : u) >= table.ratio[layer];
+				}
+
+				for (size_t i = 0; i < count; ++i)
+				{
+					if (rejected[i]) [[unlikely]]
+					{
+						dst[i] = static_cast<Real>(shift + scale * resolve(engine, words[i]));
+					}
+				}
+			}
+		}
+	} // namespace _detail
+
+	/**
+	 * @brief Concept that checks if a type is a distribution usable with `Random_t::draw`, `fill_range` and `get_vector`
+	 *
+	 * @tparam D The type to check
+	 */
+	template<typename D>
+	concept Distribution = requires(const D& dist, std::minstd_rand& engine) {
+		typename D::result_type;
+		{ dist(engine) } -> std::convertible_to<typename D::result_type>;
+	};
+
+	/**
+	 * @brief Normal distribution sampled with a 128-layer ziggurat
+	 *
+	 * @note The bulk `fill` consumes random words in blocks, so it produces a different (still deterministic)
+	 * sequence than repeated scalar calls. The same holds for every distribution below
+	 */
+	template<std::floating_point Real = double>
+	struct Normal
+	{
+		using result_type = Real;
+
+		Real mean = 0;
+		Real stddev = 1;
+
+		/**
+		 * @throw std::invalid_argument unless stddev is finite and >= 0
+		 */
+		template<std::uniform_random_bit_generator Engine>
+		[[nodiscard]] Real operator()(Engine& engine) const
+		{
+			validate();
+			return static_cast<Real>(mean + stddev * _detail::normal_from(engine, uniform_bits<uint64_t>(engine)));
+		}
+
+		template<std::uniform_random_bit_generator Engine>
+		void fill(Engine& engine, std::span<Real> out) const
+		{
+			validate();
+			_detail::fill_ziggurat<true>(engine, out, _detail::normal_table(), mean, stddev, [](Engine& eng, uint64_t word) {
+				return _detail::normal_from(eng, word);
+			});
+		}
+
+	  private:
+		void validate() const
+		{
+			if (not (stddev >= 0) or not std::isfinite(stddev))
+			{
+				throw std::invalid_argument("Normal needs a finite stddev >= 0");
+			}
+		}
+	};
+
+	/**
+	 * @brief Exponential distribution sampled with a 256-layer ziggurat
+	 */
+	template<std::floating_point Real = double>
+	struct Exponential
+	{
+		using result_type = Real;
+
+		Real lambda = 1;
+
+		/**
+		 * @throw std::invalid_argument unless lambda is finite and > 0
+		 */
+		template<std::uniform_random_bit_generator Engine>
+		[[nodiscard]] Real operator()(Engine& engine) const
+		{
+			validate();
+			return static_cast<Real>(_detail::exponential_from(engine, uniform_bits<uint64_t>(engine)) / lambda);
+		}
+
+		template<std::uniform_random_bit_generator Engine>
+		void fill(Engine& engine, std::span<Real> out) const
+		{
+			validate();
+			_detail::fill_ziggurat<false>(engine, out, _detail::exponential_table(), Real { 0 }, 1 / lambda, [](Engine& eng, uint64_t word) {
+				return _detail::exponential_from(eng, word);
+			});
+		}
+
+	  private:
+		void validate() const
+		{
+			if (not (lambda > 0) or not std::isfinite(lambda))
+			{
+				throw std::invalid_argument("Exponential needs a finite lambda > 0");
+			}
+		}
+	};
+
+	/**
+	 * @brief Log-normal distribution, `exp` of a ziggurat normal
+	 */
+	template<std::floating_point Real = double>
+	struct LogNormal
+	{
+		using result_type = Real;
+
+		Real m = 0;
+		Real s = 1;
+
+		/**
+		 * @throw std::invalid_argument unless s is finite and >= 0
+		 */
+		template<std::uniform_random_bit_generator Engine>
+		[[nodiscard]] Real operator()(Engine& engine) const
+		{
+			return std::exp(Normal<Real> { m, s }(engine));
+		}
+
+		template<std::uniform_random_bit_generator Engine>
+		void fill(Engine& engine, std::span<Real> out) const
+		{
+			Normal<Real> { m, s }.fill(engine, out);
+			for (Real& value : out)
+			{
+				value = std::exp(value);
+			}
+		}
+	};
+
+	/**
+	 * @brief Gamma distribution (Marsaglia & Tsang squeeze method on ziggurat normals)
+	 */
+	template<std::floating_point Real = double>
+	struct Gamma
+	{
+		using result_type = Real;
+
+		Real shape = 1;
+		Real scale = 1;
+
+		/**
+		 * @throw std::invalid_argument unless shape > 0 and scale > 0 (the sampler would never accept a draw)
+		 */
+		template<std::uniform_random_bit_generator Engine>
+		[[nodiscard]] Real operator()(Engine& engine) const
+		{
+			if (!(shape > 0) or !(scale > 0))
+			{
+				throw std::invalid_argument("Gamma needs shape > 0 and scale > 0");
+			}
+
+			if (shape < 1)
+			{
+				// boost to shape + 1 and scale back with U^(1 / shape)
+				const double boosted = Gamma { shape + 1, 1 }.standard(engine);
+				return static_cast<Real>(boosted * std::pow(uniform_open01(engine), 1 / static_cast<double>(shape)) * scale);
+			}
+			return static_cast<Real>(standard(engine) * scale);
+		}
+
+		template<std::uniform_random_bit_generator Engine>
+		void fill(Engine& engine, std::span<Real> out) const
+		{
+			for (Real& value : out)
+			{
+				value = (*this)(engine);
+			}
+		}
+
+	  private:
+		template<std::uniform_random_bit_generator Engine>
+		[[nodiscard]] double standard(Engine& engine) const
+		{
+			const double d = static_cast<double>(shape) - 1.0 / 3;
+			const double c = 1 / std::sqrt(9 * d);
+			for (;;)
+			{
+				const double x = _detail::normal_from(engine, uniform_bits<uint64_t>(engine));
+				const double v = 1 + c * x;
+				if (v <= 0)
+				{
+					continue;
+				}
+
+				const double v3 = v * v * v;
+				const double u = uniform_open01(engine);
+				if (u < 1 - 0.0331 * (x * x) * (x * x) or std::log(u) < 0.5 * x * x + d * (1 - v3 + std::log(v3)))
+				{
+					return d * v3;
+				}
+			}
+		}
+	};
+
+	/**
+	 * @brief Poisson distribution: inversion for small means, PTRS transformed rejection (Hormann) otherwise
+	 */
+	template<std::integral Int = int64_t>
+	struct Poisson
+	{
+		using result_type = Int;
+
+		double mean = 1;
+
+		/**
+		 * @throw std::invalid_argument unless 0 <= mean <= half the largest `Int`
+		 */
+		template<std::uniform_random_bit_generator Engine>
+		[[nodiscard]] Int operator()(Engine& engine) const
+		{
+			if (not (mean >= 0) or not (mean <= static_cast<double>(std::numeric_limits<Int>::max() / 2)))
+			{
+				throw std::invalid_argument("Poisson needs a finite mean >= 0 of at most half the largest result");
+			}
+
+			if (mean < 10)
+			{
+				Int k = 0;
+				double p = std::exp(-mean), cumulative = p;
+				for (const double u = canonical<double>(engine); u > cumulative and p > 0 and k < std::numeric_limits<Int>::max();)
+				{
+					++k;
+					p *= mean / static_cast<double>(k);
+					cumulative += p;
+				}
+				return k;
+			}
+
+			const double sqrt_mean = std::sqrt(mean), log_mean = std::log(mean);
+			const double b = 0.931 + 2.53 * sqrt_mean;
+			const double a = -0.059 + 0.02483 * b;
+			const double inv_alpha = 1.1239 + 1.1328 / (b - 3.4);
+			const double v_r = 0.9277 - 3.6224 / (b - 2);
+
+			for (;;)
+			{
+				const double u = canonical<double>(engine) - 0.5;
+				const double v = uniform_open01(engine);
+				const double us = 0.5 - std::abs(u);
+				const double k = std::floor((2 * a / us + b) * u + mean + 0.43);
+				if (k >= result_limit)
+				{
+					continue;
+				}
+
+				if (us >= 0.07 and v <= v_r)
+				{
+					return static_cast<Int>(k);
+				}
+				if (k < 0 or (us < 0.013 and v > us))
+				{
+					continue;
+				}
+				if (std::log(v) + std::log(inv_alpha) - std::log(a / (us * us) + b) <= -mean + k * log_mean - std::lgamma(k + 1))
+				{
+					return static_cast<Int>(k);
+				}
+			}
+		}
+
+		template<std::uniform_random_bit_generator Engine>
+		void fill(Engine& engine, std::span<Int> out) const
+		{
+			for (Int& value : out)
+			{
+				value = (*this)(engine);
+			}
+		}
+
+	  private:
+		// largest `Int` + 1, exact as a double
+		static constexpr double result_limit = 2.0 * static_cast<double>(std::numeric_limits<Int>::max() / 2 + 1);
+	};
+
+	/**
+	 * @class BufferedRandom
+	 * @brief Engine adapter that pre-generates blocks of 64-bit words
+	 *
+	 * The block is refilled in one tight loop over the wrapped engine, so per-call engine overhead
+	 * is paid once per block. Booleans are served bit by bit and bytes eight per word from
+	 * separate cached words. It is an engine itself, e.g. `Random_t<API_Random::BufferedRandom<std::mt19937_64>>`
+	 *
+	 * @tparam Engine The wrapped engine
+	 * @tparam BlockWords The number of words generated per refill (default: 4 KiB)
+	 */
+	template<std::uniform_random_bit_generator Engine, size_t BlockWords = 512>
+	class BufferedRandom
+	{
+	  public:
+		using result_type = uint64_t;
+		using engine_type = Engine;
+
+		static constexpr auto default_seed = Engine::default_seed;
+
+		BufferedRandom() = default;
+
+		explicit BufferedRandom(Engine engine)
+			: m_engine(std::move(engine))
+		{
+		}
+
+		template<typename Seed>
+			requires std::constructible_from<Engine, Seed&&> && (not std::same_as<std::remove_cvref_t<Seed>, BufferedRandom>)
+					 && (not std::same_as<std::remove_cvref_t<Seed>, Engine>)
+		explicit BufferedRandom(Seed&& seed)
+			: m_engine(std::forward<Seed>(seed))
+		{
+		}
+
+		/**
+		 * @brief Reseed the wrapped engine and drop all buffered bits
+		 */
+		template<typename... Args>
+		void seed(Args&&... args)
+		{
+			m_engine.seed(std::forward<Args>(args)...);
+			m_pos = BlockWords;
+			m_bits_left = m_bytes_left = 0;
+		}
+
+		[[nodiscard]] static constexpr result_type min() noexcept
+		{
+			return 0;
+		}
+
+		[[nodiscard]] static constexpr result_type max() noexcept
+		{
+			return std::numeric_limits<result_type>::max();
+		}
+
+		result_type operator()()
+		{
+			if (m_pos == BlockWords) [[unlikely]]
+			{
+				refill();
+			}
+			return m_block[m_pos++];
+		}
+
+		void discard(unsigned long long count)
+		{
+			for (; count != 0; --count)
+			{
+				(void)(*this)();
+			}
+		}
+
+		/**
+		 * @brief Get one random bit
+		 */
+		[[nodiscard]] bool next_bool()
+		{
+			if (m_bits_left == 0)
+			{
+				m_bits = (*this)();
+				m_bits_left = 64;
+			}
+
+			const bool bit = m_bits & 1;
+			m_bits >>= 1;
+			--m_bits_left;
+
+			return bit;
+		}
+
+		/**
+		 * @brief Get one random byte
+		 */
+		[[nodiscard]] uint8_t next_byte()
+		{
+			if (m_bytes_left == 0)
+			{
+				m_bytes = (*this)();
+				m_bytes_left = 8;
+			}
+
+			const auto byte = static_cast<uint8_t>(m_bytes);
+			m_bytes >>= 8;
+			--m_bytes_left;
+
+			return byte;
+		}
+
+		/**
+		 * @brief Get a random integer in `[min_val, max_val]` from the block
+		 */
+		template<std::integral Int>
+		[[nodiscard]] Int in_range(Int min_val, Int max_val)
+		{
+			return bounded_in_range(*this, min_val, max_val);
+		}
+
+		[[nodiscard]] Engine& engine() noexcept
+		{
+			return m_engine;
+		}
+
+	  private:
+		Engine m_engine;
+		std::array<uint64_t, BlockWords> m_block;
+		size_t m_pos = BlockWords;
+
+		uint64_t m_bits = 0, m_bytes = 0;
+		int m_bits_left = 0, m_bytes_left = 0;
+
+		void refill()
+		{
+			for (auto& word : m_block)
+			{
+				word = uniform_bits<uint64_t>(m_engine);
+			}
+			m_pos = 0;
+		}
+	};
+
+	/**
+	 * @class Charset
+	 * @brief A flat table of distinct bytes used for string generation
+	 *
+	 * The allowed symbols are materialized once, so generating a character is a single table lookup
+	 * instead of a walk over a filtered range. Repeated symbols are collapsed
+	 */
+	class Charset
+	{
+	  public:
+		constexpr Charset() noexcept = default;
+
+		/**
+		 * @brief Construct a charset from the given symbols
+		 *
+		 * @param symbols The symbols to use
+		 */
+		constexpr explicit Charset(std::string_view symbols) noexcept
+		{
+			for (const char c : symbols)
+			{
+				add(c);
+			}
+		}
+
+		/**
+		 * @brief Construct a charset from all bytes satisfying a predicate
+		 *
+		 * @param pred The predicate `(isalpha, isprint, ...)` called with every value in `[0, 256)`
+		 * @return A charset of the bytes that satisfy the predicate
+		 */
+		template<typename Pred>
+			requires std::is_invocable_v<Pred&, int>
+		[[nodiscard]] static constexpr Charset from_predicate(Pred&& pred)
+		{
+			Charset charset;
+			for (int c = 0; c < 256; ++c)
+			{
+				if (pred(c))
+				{
+					charset.add(static_cast<char>(c));
+				}
+			}
+			return charset;
+		}
+
+		[[nodiscard]] constexpr bool contains(char c) const noexcept
+		{
+			const auto byte = static_cast<unsigned char>(c);
+			return (m_present[byte / 64] >> (byte % 64)) & 1;
+		}
+
+		[[nodiscard]] constexpr size_t size() const noexcept
+		{
+			return m_size;
+		}
+
+		[[nodiscard]] constexpr bool empty() const noexcept
+		{
+			return m_size == 0;
+		}
+
+		[[nodiscard]] constexpr std::string_view view() const noexcept
+		{
+			return { m_table.data(), m_size };
+		}
+
+		[[nodiscard]] constexpr operator std::string_view() const noexcept
+		{
+			return view();
+		}
+
+	  private:
+		std::array<char, 256> m_table {};
+		std::array<uint64_t, 4> m_present {};
+		uint16_t m_size = 0;
+
+		constexpr void add(char c) noexcept
+		{
+			if (not contains(c))
+			{
+				const auto byte = static_cast<unsigned char>(c);
+				m_present[byte / 64] |= uint64_t { 1 } << (byte % 64);
+				m_table[m_size++] = c;
+			}
+		}
+	};
+
+	/**
+	 * @brief Predefined charsets, in ascending byte order
+	 */
+	namespace Charsets
+	{
+		inline constexpr Charset digits { "0123456789" };
+		inline constexpr Charset hex { "0123456789abcdef" };
+		inline constexpr Charset hex_upper { "0123456789ABCDEF" };
+		inline constexpr Charset alpha { "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz" };
+		inline constexpr Charset alnum { "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz" };
+		inline constexpr Charset base64 { "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/" };
+		inline constexpr Charset base64url { "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_" };
+	} // namespace Charsets
+
+	/**
+	 * @brief Fill a buffer with symbols chosen uniformly from a table
+	 *
+	 * Several symbols are drawn from every 64-bit word: power-of-two tables slice the word into bit fields,
+	 * other tables use batched multiply-shift with a single rejection check per word
+	 *
+	 * @param engine The engine to draw from
+	 * @param out The buffer to fill
+	 * @param symbols The symbols to choose from (left untouched if empty)
+	 */
+	template<std::uniform_random_bit_generator Engine>
+	constexpr void fill_chars(Engine& engine, std::span<char> out, std::string_view symbols)
+	{
+		const uint64_t count = symbols.size();
+		if (count == 0)
+		{
+			return;
+		}
+
+		if (count == 1)
+		{
+			std::ranges::fill(out, symbols.front());
+		}
+		else if (std::has_single_bit(count) and count <= (uint64_t { 1 } << 32))
+		{
+			const int bits = std::countr_zero(count);
+			const size_t per_word = 64 / bits;
+			const uint64_t mask = count - 1;
+
+			for (size_t i = 0; i < out.size(); i += per_word)
+			{
+				uint64_t word = uniform_bits<uint64_t>(engine);
+				for (size_t j = i, end = std::min(out.size(), i + per_word); j < end; ++j, word >>= bits)
+				{
+					out[j] = symbols[word & mask];
+				}
+			}
+		}
+		else
+		{
+			size_t per_word = 0;
+			uint64_t product = 1;
+			while (product <= std::numeric_limits<uint64_t>::max() / count)
+			{
+				product *= count;
+				++per_word;
+			}
+
+			std::array<uint64_t, 64> indices;
+			for (size_t i = 0; i < out.size(); i += per_word)
+			{
+				const auto draw = [&] {
+					uint64_t rest = uniform_bits<uint64_t>(engine);
+					for (size_t k = 0; k < per_word; ++k)
+					{
+						indices[k] = mul_64x64(rest, count, rest);
+					}
+					return rest;
+				};
+
+				if (const uint64_t rest = draw(); rest < product) [[unlikely]]
+				{
+					const uint64_t threshold = (0 - product) % product;
+					for (uint64_t r = rest; r < threshold;)
+					{
+						r = draw();
+					}
+				}
+
+				for (size_t j = i, k = 0, end = std::min(out.size(), i + per_word); j < end; ++j, ++k)
+				{
+					out[j] = symbols[indices[k]];
+				}
+			}
+		}
+	}
+
+	/**
+	 * @class RandomStringBatch
+	 * @brief A set of random strings stored back to back in one contiguous arena
+	 *
+	 * String `i` spans `[offsets()[i], offsets()[i + 1])` of the arena, so generating N strings
+	 * costs two allocations instead of N
+	 */
+	class RandomStringBatch
+	{
+	  public:
+		RandomStringBatch() = default;
+
+		/**
+		 * @brief Generate a batch of random strings
+		 *
+		 * @param engine The engine to draw from
+		 * @param count The number of strings
+		 * @param min_len The minimum length of the strings (inclusive)
+		 * @param max_len The maximum length of the strings (inclusive)
+		 * @param symbols The symbols to choose from
+		 * @return The generated batch
+		 */
+		template<std::uniform_random_bit_generator Engine>
+		[[nodiscard]] static RandomStringBatch generate(Engine& engine, size_t count, size_t min_len, size_t max_len, std::string_view symbols)
+		{
+			RandomStringBatch batch;
+			batch.m_offsets.resize(count + 1);
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				batch.m_offsets[i + 1] = batch.m_offsets[i] + bounded_in_range(engine, min_len, max_len);
+			}
+
+			batch.m_arena.resize(batch.m_offsets.back());
+			fill_chars(engine, batch.m_arena, symbols);
+
+			return batch;
+		}
+
+		[[nodiscard]] size_t size() const noexcept
+		{
+			return m_offsets.empty() ? 0 : m_offsets.size() - 1;
+		}
+
+		[[nodiscard]] bool empty() const noexcept
+		{
+			return size() == 0;
+		}
+
+		[[nodiscard]] std::string_view operator[](size_t idx) const noexcept
+		{
+			return std::string_view(m_arena).substr(m_offsets[idx], m_offsets[idx + 1] - m_offsets[idx]);
+		}
+
+		/**
+		 * @brief Get all strings of the batch as a random access view of `std::string_view`
+		 */
+		[[nodiscard]] auto views() const
+		{
+			return std::views::iota(size_t { 0 }, size()) | std::views::transform([this](size_t idx) { return (*this)[idx]; });
+		}
+
+		/**
+		 * @brief Get the arena holding all strings back to back
+		 */
+		[[nodiscard]] std::string_view arena() const noexcept
+		{
+			return m_arena;
+		}
+
+		/**
+		 * @brief Get the start offsets of all strings, followed by the total arena size
+		 */
+		[[nodiscard]] std::span<const size_t> offsets() const noexcept
+		{
+			return m_offsets;
+		}
+
+		/**
+		 * @brief Copy the strings out of the arena
+		 *
+		 * @tparam T The string type of the vector elements
+		 * @return A vector holding a copy of every string
+		 */
+		template<typename T = std::string>
+			requires std::constructible_from<T, std::string_view>
+		[[nodiscard]] std::vector<T> to_vector() const
+		{
+			std::vector<T> result;
+			result.reserve(size());
+			for (size_t idx = 0; idx < size(); ++idx)
+			{
+				result.emplace_back((*this)[idx]);
+			}
+			return result;
+		}
+
+	  private:
+		std::string m_arena;
+		std::vector<size_t> m_offsets;
+	};
+
+	/**
+	 * @brief Advance a splitmix64 state and return its next output
+	 *
+	 * @param state The generator state
+	 * @return A well-mixed 64-bit value
+	 */
+	[[nodiscard]] constexpr uint64_t splitmix64(uint64_t& state) noexcept
+	{
+		uint64_t z = (state += 0x9E3779B97F4A7C15);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+		return z ^ (z >> 31);
+	}
+
+	/**
+	 * @class LinearCongruential
+	 * @brief A constexpr `std::linear_congruential_engine`
+	 *
+	 * Seeding (including from a seed sequence) and stepping follow the standard, so it produces the same
+	 * sequence as the std engine with the same parameters, at compile time as well as at runtime.
+	 * `MinstdRand` matches `std::minstd_rand`, the default engine of `Random_t`
+	 *
+	 * @note The modulus must be 0 (i.e. 2^w) or at most 2^32
+	 */
+	template<std::unsigned_integral UInt, UInt a, UInt c, UInt m>
+		requires(m == 0 or (m <= (uint64_t { 1 } << 32) and a < m and c < m))
+	class LinearCongruential
+	{
+	  public:
+		using result_type = UInt;
+
+		static constexpr result_type multiplier = a;
+		static constexpr result_type increment = c;
+		static constexpr result_type modulus = m;
+		static constexpr result_type default_seed = 1u;
+
+		constexpr LinearCongruential() noexcept
+			: LinearCongruential(default_seed)
+		{
+		}
+
+		constexpr explicit LinearCongruential(result_type seed) noexcept
+		{
+			this->seed(seed);
+		}
+
+		template<typename SeedSeq>
+			requires(not std::is_convertible_v<SeedSeq, result_type>) && requires(SeedSeq& seq, uint32_t* out) { seq.generate(out, out); }
+		explicit LinearCongruential(SeedSeq& seq)
+		{
+			constexpr int bits = m == 0 ? std::numeric_limits<UInt>::digits : std::bit_width(uint64_t { m } - 1);
+			constexpr size_t words = (bits + 31) / 32;
+
+			std::array<uint32_t, words + 3> generated;
+			seq.generate(generated.begin(), generated.end());
+
+			uint64_t sum = 0;
+			for (size_t j = 0; j < words; ++j)
+			{
+				sum += uint64_t { generated[j + 3] } << (32 * j);
+			}
+			seed(static_cast<result_type>(m == 0 ? sum : sum % m));
+		}
+
+		constexpr void seed(result_type seed = default_seed) noexcept
+		{
+			const result_type value = m == 0 ? seed : static_cast<result_type>(seed % m);
+			m_state = (c == 0 and value == 0) ? 1 : value;
+		}
+
+		[[nodiscard]] static constexpr result_type min() noexcept
+		{
+			return c == 0 ? 1 : 0;
+		}
+
+		[[nodiscard]] static constexpr result_type max() noexcept
+		{
+			return m == 0 ? std::numeric_limits<result_type>::max() : m - 1;
+		}
+
+		constexpr result_type operator()() noexcept
+		{
+			if constexpr (m == 0)
+			{
+				m_state = static_cast<result_type>(a * m_state + c);
+			}
+			else
+			{
+				m_state = static_cast<result_type>((uint64_t { a } * m_state + c) % m);
+			}
+			return m_state;
+		}
+
+		constexpr void discard(unsigned long long count) noexcept
+		{
+			for (; count != 0; --count)
+			{
+				(void)(*this)();
+			}
+		}
+
+		friend constexpr bool operator==(const LinearCongruential&, const LinearCongruential&) noexcept = default;
+
+	  private:
+		result_type m_state = 1;
+	};
+
+	using MinstdRand0 = LinearCongruential<uint_fast32_t, 16807, 0, 2147483647>;
+	using MinstdRand = LinearCongruential<uint_fast32_t, 48271, 0, 2147483647>;
+
+	// the 10000th output of a default-seeded engine, as required of std::minstd_rand0 / std::minstd_rand
+	static_assert([] {
+		MinstdRand0 engine;
+		engine.discard(9999);
+		return engine();
+	}() == 1043618065);
+	static_assert([] {
+		MinstdRand engine;
+		engine.discard(9999);
+		return engine();
+	}() == 399268537);
+
+	template<typename Engine>
+	struct is_linear_congruential : std::false_type
+	{
+	};
+
+	template<typename UInt, UInt a, UInt c, UInt m>
+	struct is_linear_congruential<std::linear_congruential_engine<UInt, a, c, m>> : std::true_type
+	{
+	};
+
+	template<typename UInt, UInt a, UInt c, UInt m>
+	struct is_linear_congruential<LinearCongruential<UInt, a, c, m>> : std::true_type
+	{
+	};
+
+	/**
+	 * @brief Advance an engine by `count` steps, as if `engine()` was called `count` times
+	 *
+	 * Linear congruential engines with a modulus up to 2^32 (or a power-of-two modulus) jump
+	 * in O(log count) by exponentiating the affine step; other engines fall back to `discard`
+	 *
+	 * @param engine The engine to advance
+	 * @param count The number of steps to skip
+	 */
+	template<std::uniform_random_bit_generator Engine>
+	constexpr void jump(Engine& engine, unsigned long long count)
+	{
+		if constexpr (is_linear_congruential<Engine>::value)
+		{
+			using UInt = typename Engine::result_type;
+			constexpr uint64_t m = Engine::modulus;
+
+			if constexpr (m == 0 or m <= (uint64_t { 1 } << 32))
+			{
+				if (count == 0)
+				{
+					return;
+				}
+
+				const auto mul_mod = [](uint64_t x, uint64_t y) -> uint64_t {
+					if constexpr (m == 0)
+					{
+						return static_cast<UInt>(static_cast<UInt>(x) * static_cast<UInt>(y));
+					}
+					else
+					{
+						return (x * y) % m;
+					}
+				};
+				const auto add_mod = [](uint64_t x, uint64_t y) -> uint64_t {
+					if constexpr (m == 0)
+					{
+						return static_cast<UInt>(static_cast<UInt>(x) + static_cast<UInt>(y));
+					}
+					else
+					{
+						return (x + y) % m;
+					}
+				};
+
+				// the next output is the state after one step, so only count - 1 steps remain
+				uint64_t state = Engine(engine)();
+				uint64_t step_mul = Engine::multiplier, step_add = Engine::increment;
+				uint64_t total_mul = 1, total_add = 0;
+
+				for (auto steps = count - 1; steps != 0; steps >>= 1)
+				{
+					if (steps & 1)
+					{
+						total_mul = mul_mod(total_mul, step_mul);
+						total_add = add_mod(mul_mod(total_add, step_mul), step_add);
+					}
+					step_add = mul_mod(add_mod(step_mul, 1), step_add);
+					step_mul = mul_mod(step_mul, step_mul);
+				}
+
+				engine.seed(static_cast<UInt>(add_mod(mul_mod(total_mul, state), total_add)));
+				return;
+			}
+		}
+
+		engine.discard(count);
+	}
+
+	static_assert([] {
+		MinstdRand jumped(42), stepped(42);
+		jump(jumped, 1000);
+		stepped.discard(1000);
+		return jumped == stepped;
+	}());
+
+	/**
+	 * @brief Derive an independent engine for a numbered stream
+	 *
+	 * The engine state is filled through `std::seed_seq` (or the single-value constructor for engines without one)
+	 * from splitmix64 outputs of `(key, stream_id)`, so the same pair always yields the same stream on every platform
+	 *
+	 * @tparam Engine The engine type to create
+	 * @param key The key shared by all streams of one job
+	 * @param stream_id The index of the stream
+	 * @return A seeded engine
+	 */
+	template<std::uniform_random_bit_generator Engine>
+	[[nodiscard]] Engine make_stream(uint64_t key, uint64_t stream_id)
+	{
+		uint64_t state = key ^ splitmix64(stream_id);
+		const uint64_t lo = splitmix64(state), hi = splitmix64(state);
+
+		if constexpr (std::constructible_from<Engine, std::seed_seq&>)
+		{
+			std::seed_seq seq {
+				static_cast<uint32_t>(lo), static_cast<uint32_t>(lo >> 32), static_cast<uint32_t>(hi), static_cast<uint32_t>(hi >> 32)
+			};
+			return Engine(seq);
+		}
+		else
+		{
+			return Engine(static_cast<typename Engine::result_type>(lo));
+		}
+	}
+
+	/**
+	 * @brief Number of elements generated from one derived stream by the parallel `Random_t` overloads
+	 *
+	 * @note Part of the output definition: changing it changes the generated values
+	 */
+	inline constexpr size_t stream_block_size = size_t { 1 } << 16;
+
+	/**
+	 * @brief Shuffle `count` elements with a batched Fisher-Yates
+	 *
+	 * While the product of the next bounds fits in 64 bits, several swap indices are taken from one
+	 * random word with batched multiply-shift (Brackett-Rozinsky & Lemire), with a single rejection check.
+	 * Indices are drawn a window ahead of the swaps so the cache misses of large ranges overlap
+	 *
+	 * @param first The iterator to the first element
+	 * @param count The number of elements
+	 * @param engine The engine to draw from
+	 */
+	template<std::random_access_iterator It, std::uniform_random_bit_generator Engine>
+	constexpr void shuffle(It first, size_t count, Engine& engine)
+	{
+		using Diff = std::iter_difference_t<It>;
+		constexpr size_t max_batch = 6;
+		constexpr size_t window = 64;
+		std::array<uint64_t, window> picks {};
+
+		const auto product_of = [](uint64_t bound, size_t batch) {
+			uint64_t product = bound;
+			for (size_t k = 1; k < batch; ++k)
+			{
+				product *= bound - k;
+			}
+			return product;
+		};
+
+		for (uint64_t remaining = count; remaining > 1;)
+		{
+			// bounds only shrink, so a batch size that fits now fits for the whole window
+			size_t batch = 1;
+			uint64_t product = remaining;
+			for (uint64_t low; batch < max_batch and remaining - batch > 1 and mul_64x64(product, remaining - batch, low) == 0; ++batch)
+			{
+				product = low;
+			}
+
+			const size_t rounds = static_cast<size_t>(std::clamp<uint64_t>((remaining - 1) / batch, 1, window / batch));
+			for (size_t round = 0; round < rounds; ++round)
+			{
+				const uint64_t bound = remaining - round * batch;
+				uint64_t* const out = picks.data() + round * batch;
+				const auto draw = [&] {
+					uint64_t rest = uniform_bits<uint64_t>(engine);
+					for (size_t k = 0; k < batch; ++k)
+					{
+						out[k] = mul_64x64(rest, bound - k, rest);
+					}
+					return rest;
+				};
+
+				// `product` bounds this round's product from above, so the exact one is only needed on a near miss
+				if (const uint64_t rest = draw(); rest < product) [[unlikely]]
+				{
+					const uint64_t exact = product_of(bound, batch);
+					const uint64_t threshold = (0 - exact) % exact;
+					for (uint64_t r = rest; r < threshold;)
+					{
+						r = draw();
+					}
+				}
+			}
+
+			for (size_t round = 0; round < rounds; ++round)
+			{
+				const uint64_t bound = remaining - round * batch;
+				for (size_t k = 0; k < batch; ++k)
+				{
+					std::ranges::iter_swap(first + static_cast<Diff>(bound - 1 - k), first + static_cast<Diff>(picks[round * batch + k]));
+				}
+			}
+			remaining -= rounds * batch;
+		}
+	}
+
+	/**
+	 * @brief Merge two independently shuffled adjacent blocks into one shuffled block (MergeShuffle, Bacher et al.)
+	 *
+	 * @param first The iterator to the first element of the left block
+	 * @param mid The size of the left block
+	 * @param count The total size of both blocks
+	 * @param engine The engine to draw from
+	 */
+	template<std::random_access_iterator It, std::uniform_random_bit_generator Engine>
+	constexpr void merge_shuffled(It first, size_t mid, size_t count, Engine& engine)
+	{
+		using Diff = std::iter_difference_t<It>;
+
+		size_t left = 0, right = mid;
+		uint64_t coins = 0;
+		int coins_left = 0;
+
+		for (;; ++left)
+		{
+			if (coins_left == 0)
+			{
+				coins = uniform_bits<uint64_t>(engine);
+				coins_left = 64;
+			}
+			const bool take_right = coins & 1;
+			coins >>= 1;
+			--coins_left;
+
+			if (take_right)
+			{
+				if (right == count)
+				{
+					break;
+				}
+				std::ranges::iter_swap(first + static_cast<Diff>(left), first + static_cast<Diff>(right++));
+			}
+			else if (left == right)
+			{
+				break;
+			}
+		}
+
+		for (; left < count; ++left)
+		{
+			std::ranges::iter_swap(first + static_cast<Diff>(left), first + static_cast<Diff>(bounded_in_range(engine, size_t { 0 }, left)));
+		}
+	}
+
+	/**
+	 * @brief Reproducible parallel shuffle (MergeShuffle)
+	 *
+	 * Blocks of `block_size` elements are shuffled in parallel with batched Fisher-Yates, then merged
+	 * pairwise level by level. Every block and merge uses its own stream derived from `key`, so the
+	 * permutation depends only on `key`, `count` and `block_size`, never on the execution policy
+	 *
+	 * @tparam Engine The engine type of the derived streams
+	 * @param policy The execution policy used for blocks and merges
+	 * @param first The iterator to the first element
+	 * @param count The number of elements
+	 * @param key The key of the derived streams
+	 * @param block_size The number of elements shuffled sequentially per block
+	 */
+	template<std::uniform_random_bit_generator Engine, typename ExecutionPolicy, std::random_access_iterator It>
+		requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+	void parallel_shuffle(ExecutionPolicy&& policy, It first, size_t count, uint64_t key, size_t block_size = stream_block_size)
+	{
+		using Diff = std::iter_difference_t<It>;
+
+		block_size = std::max<size_t>(block_size, 1);
+		std::vector<size_t> tasks((count + block_size - 1) / block_size);
+		std::iota(tasks.begin(), tasks.end(), size_t { 0 });
+
+		std::for_each(policy, tasks.begin(), tasks.end(), [&](size_t block) {
+			auto engine = make_stream<Engine>(key, block);
+			const size_t begin = block * block_size;
+			shuffle(first + static_cast<Diff>(begin), std::min(block_size, count - begin), engine);
+		});
+
+		for (uint64_t level = 1, width = block_size; width < count; ++level, width *= 2)
+		{
+			tasks.resize((count + 2 * width - 1) / (2 * width));
+			std::iota(tasks.begin(), tasks.end(), size_t { 0 });
+
+			std::for_each(policy, tasks.begin(), tasks.end(), [&](size_t pair) {
+				const size_t begin = pair * 2 * width;
+				const size_t size = std::min(2 * width, count - begin);
+				if (size > width)
+				{
+					auto engine = make_stream<Engine>(key, level << 40 | pair);
+					merge_shuffled(first + static_cast<Diff>(begin), width, size, engine);
+				}
+			});
+		}
+	}
+
+	/**
+	 * @class Philox4x32
+	 * @brief Counter-based Philox4x32-10 engine (Salmon et al., "Parallel random numbers: as easy as 1, 2, 3")
+	 *
+	 * Every block of four 32-bit outputs is a pure function of `(key, stream, block index)`,
+	 * so any value of the stream is available in O(1) through `at`/`block` and `discard` is O(1).
+	 * It satisfies the engine requirements used by `Random_t`, e.g. `Random_t<API_Random::Philox4x32>`
+	 */
+	class Philox4x32
+	{
+	  public:
+		using result_type = uint32_t;
+		using block_type = std::array<uint32_t, 4>;
+
+		static constexpr uint64_t default_seed = 0;
+
+		constexpr Philox4x32() noexcept
+			: Philox4x32(default_seed)
+		{
+		}
+
+		/**
+		 * @brief Construct an engine from a key and a stream id
+		 *
+		 * @param seed The key of the generator
+		 * @param stream The stream id (independent sequences for the same key)
+		 */
+		constexpr explicit Philox4x32(uint64_t seed, uint64_t stream = 0) noexcept
+		{
+			this->seed(seed, stream);
+		}
+
+		template<typename SeedSeq>
+			requires(not std::is_convertible_v<SeedSeq, uint64_t>) && requires(SeedSeq& seq, uint32_t* out) { seq.generate(out, out); }
+		explicit Philox4x32(SeedSeq& seq)
+		{
+			std::array<uint32_t, 4> words;
+			seq.generate(words.begin(), words.end());
+			seed(words[0] | uint64_t { words[1] } << 32, words[2] | uint64_t { words[3] } << 32);
+		}
+
+		constexpr void seed(uint64_t seed = default_seed, uint64_t stream = 0) noexcept
+		{
+			m_key = { static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32) };
+			m_stream = stream;
+			m_position = 0;
+			m_buffered = false;
+		}
+
+		[[nodiscard]] static constexpr result_type min() noexcept
+		{
+			return 0;
+		}
+
+		[[nodiscard]] static constexpr result_type max() noexcept
+		{
+			return std::numeric_limits<result_type>::max();
+		}
+
+		constexpr result_type operator()() noexcept
+		{
+			if (not m_buffered or (m_position & 3) == 0)
+			{
+				m_buffer = block(m_position >> 2);
+				m_buffered = true;
+			}
+			return m_buffer[m_position++ & 3];
+		}
+
+		constexpr void discard(unsigned long long count) noexcept
+		{
+			if ((m_position & ~uint64_t { 3 }) != ((m_position + count) & ~uint64_t { 3 }))
+			{
+				m_buffered = false;
+			}
+			m_position += count;
+		}
+
+		/**
+		 * @brief Get the four outputs of a block without touching the engine position
+		 *
+		 * @param index The block index
+		 * @return The outputs `at(4 * index)` .. `at(4 * index + 3)`
+		 */
+		[[nodiscard]] constexpr block_type block(uint64_t index) const noexcept
+		{
+			block_type ctr { static_cast<uint32_t>(index), static_cast<uint32_t>(index >> 32),
+							 static_cast<uint32_t>(m_stream), static_cast<uint32_t>(m_stream >> 32) };
+			auto key = m_key;
+
+			for (int round = 0; round < 10; ++round)
+			{
+				if (round != 0)
+				{
+					key[0] += 0x9E3779B9;
+					key[1] += 0xBB67AE85;
+				}
+
+				const uint64_t p0 = uint64_t { 0xD2511F53 } * ctr[0];
+				const uint64_t p1 = uint64_t { 0xCD9E8D57 } * ctr[2];
+
+				ctr = { static_cast<uint32_t>(p1 >> 32) ^ ctr[1] ^ key[0], static_cast<uint32_t>(p1),
+						static_cast<uint32_t>(p0 >> 32) ^ ctr[3] ^ key[1], static_cast<uint32_t>(p0) };
+			}
+			return ctr;
+		}
+
+		/**
+		 * @brief Compute consecutive blocks without touching the engine position
+		 *
+		 * The round keys are computed once and every block is independent, so the loop vectorizes
+		 *
+		 * @param first The index of the first block
+		 * @param out The blocks `block(first)` .. `block(first + out.size() - 1)`
+		 */
+		constexpr void blocks(uint64_t first, std::span<block_type> out) const noexcept
+		{
+			std::array<uint32_t, 10> key0, key1;
+			key0[0] = m_key[0];
+			key1[0] = m_key[1];
+			for (int round = 1; round < 10; ++round)
+			{
+				key0[round] = key0[round - 1] + 0x9E3779B9;
+				key1[round] = key1[round - 1] + 0xBB67AE85;
+			}
+
+			for (size_t i = 0; i < out.size(); ++i)
+			{
+				const uint64_t index = first + i;
+				uint32_t c0 = static_cast<uint32_t>(index), c1 = static_cast<uint32_t>(index >> 32);
+				uint32_t c2 = static_cast<uint32_t>(m_stream), c3 = static_cast<uint32_t>(m_stream >> 32);
+
+				for (int round = 0; round < 10; ++round)
+				{
+					const uint64_t p0 = uint64_t { 0xD2511F53 } * c0;
+					const uint64_t p1 = uint64_t { 0xCD9E8D57 } * c2;
+
+					c0 = static_cast<uint32_t>(p1 >> 32) ^ c1 ^ key0[round];
+					c1 = static_cast<uint32_t>(p1);
+					c2 = static_cast<uint32_t>(p0 >> 32) ^ c3 ^ key1[round];
+					c3 = static_cast<uint32_t>(p0);
+				}
+				out[i] = { c0, c1, c2, c3 };
+			}
+		}
+
+		/**
+		 * @brief Get the i-th output of the stream in O(1)
+		 *
+		 * @param index The position in the stream
+		 * @return The value the engine returns after `discard(index)`
+		 */
+		[[nodiscard]] constexpr result_type at(uint64_t index) const noexcept
+		{
+			return block(index >> 2)[index & 3];
+		}
+
+		/**
+		 * @brief Get the number of values drawn so far
+		 */
+		[[nodiscard]] constexpr uint64_t position() const noexcept
+		{
+			return m_position;
+		}
+
+		[[nodiscard]] constexpr uint64_t stream() const noexcept
+		{
+			return m_stream;
+		}
+
+		friend constexpr bool operator==(const Philox4x32& lhs, const Philox4x32& rhs) noexcept
+		{
+			return lhs.m_key == rhs.m_key and lhs.m_stream == rhs.m_stream and lhs.m_position == rhs.m_position;
+		}
+
+	  private:
+		std::array<uint32_t, 2> m_key {};
+		uint64_t m_stream = 0;
+		uint64_t m_position = 0;
+		block_type m_buffer {};
+		bool m_buffered = false;
+	};
+
+	// known-answer vectors of the Random123 reference (philox4x32_10, counter = { index, stream }, key = seed)
+	static_assert(Philox4x32(0).block(0) == Philox4x32::block_type { 0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8 });
+	static_assert(Philox4x32(0xffffffffffffffff, 0xffffffffffffffff).block(0xffffffffffffffff)
+				  == Philox4x32::block_type { 0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd });
+	static_assert(Philox4x32(0x299f31d0a4093822, 0x0370734413198a2e).block(0x85a308d3243f6a88)
+				  == Philox4x32::block_type { 0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1 });
+
+	/**
+	 * @brief Generate the i-th value of an index-addressable sequence of integers in `[min_val, max_val]`
+	 *
+	 * Element i is computed from the 128 bits of block i alone, with no rejection loop,
+	 * so any slice can be generated independently; the bias is below 2^-64
+	 *
+	 * @tparam Int The integral type of the result
+	 * @param gen The counter-based generator (its position is ignored)
+	 * @param index The element index
+	 * @param min_val The minimum value (inclusive)
+	 * @param max_val The maximum value (inclusive)
+	 * @return The element at the index
+	 */
+	template<std::integral Int>
+	[[nodiscard]] constexpr Int bounded_at(const Philox4x32& gen, uint64_t index, Int min_val, Int max_val) noexcept
+	{
+		using UInt = std::make_unsigned_t<Int>;
+
+		if (max_val < min_val)
+		{
+			std::swap(min_val, max_val);
+		}
+
+		const auto words = gen.block(index);
+		const uint64_t hi = words[0] | uint64_t { words[1] } << 32;
+		const uint64_t lo = words[2] | uint64_t { words[3] } << 32;
+		const uint64_t span = static_cast<uint64_t>(static_cast<UInt>(static_cast<UInt>(max_val) - static_cast<UInt>(min_val)));
+
+		uint64_t offset;
+		if (span == std::numeric_limits<uint64_t>::max())
+		{
+			offset = hi;
+		}
+		else
+		{
+			// floor((hi:lo) * bound / 2^128), computed from the partial products
+			uint64_t discard, top_lo;
+			const uint64_t top = mul_64x64(hi, span + 1, top_lo);
+			const uint64_t carry_in = mul_64x64(lo, span + 1, discard);
+			offset = top + (top_lo + carry_in < top_lo);
+		}
+
+		return static_cast<Int>(static_cast<UInt>(static_cast<UInt>(min_val) + static_cast<UInt>(offset)));
+	}
+
+	/**
+	 * @brief Lazily computed view of `bounded_at` values
+	 *
+	 * @param gen The counter-based generator
+	 * @param count The number of elements
+	 * @param min_val The minimum value (inclusive)
+	 * @param max_val The maximum value (inclusive)
+	 * @return A random access view that recomputes element i on access
+	 */
+	template<std::integral Int>
+	[[nodiscard]] constexpr auto random_view(const Philox4x32& gen, uint64_t count, Int min_val, Int max_val)
+	{
+		return std::views::iota(uint64_t { 0 }, count) | std::views::transform([gen, min_val, max_val](uint64_t index) {
+				   return bounded_at(gen, index, min_val, max_val);
+			   });
+	}
+
+	/**
+	 * @brief Fill a buffer with random bytes
+	 *
+	 * The bytes are the little-endian bytes of consecutive `uniform_bits<uint64_t>` words, the last
+	 * word truncated, so the output is the same on every platform. Words are generated into a small
+	 * block and copied out with one memcpy; `Philox4x32` at a block boundary computes whole blocks
+	 * at once through `Philox4x32::blocks`
+	 *
+	 * @param engine The engine to draw from
+	 * @param out The buffer to fill
+	 */
+	template<std::uniform_random_bit_generator Engine>
+	void fill_bytes(Engine& engine, std::span<std::byte> out)
+	{
+		constexpr size_t block_words = 64;
+		std::array<uint64_t, block_words> words;
+
+		std::byte* data = out.data();
+		size_t left = out.size();
+
+		const auto store = [&](size_t count, size_t bytes) {
+			if constexpr (std::endian::native == std::endian::big)
+			{
+				for (size_t i = 0; i < count; ++i)
+				{
+					words[i] = std::byteswap(words[i]);
+				}
+			}
+			std::memcpy(data, words.data(), bytes);
+			data += bytes;
+			left -= bytes;
+		};
+
+		if constexpr (std::same_as<Engine, Philox4x32>)
+		{
+			if (engine.position() % 4 == 2 and left >= 8)
+			{
+				words[0] = uniform_bits<uint64_t>(engine);
+				store(1, 8);
+			}
+
+			if (engine.position() % 4 == 0)
+			{
+				std::array<Philox4x32::block_type, block_words / 2> blocks;
+				while (left >= 16)
+				{
+					const size_t count = std::min(blocks.size(), left / 16);
+					engine.blocks(engine.position() / 4, std::span(blocks).first(count));
+					for (size_t i = 0; i < count; ++i)
+					{
+						words[2 * i] = uint64_t { blocks[i][0] } << 32 | blocks[i][1];
+						words[2 * i + 1] = uint64_t { blocks[i][2] } << 32 | blocks[i][3];
+					}
+					engine.discard(4 * count);
+					store(2 * count, 16 * count);
+				}
+			}
+		}
+
+		while (left >= 8)
+		{
+			const size_t count = std::min(block_words, left / 8);
+			for (size_t i = 0; i < count; ++i)
+			{
+				words[i] = uniform_bits<uint64_t>(engine);
+			}
+			store(count, 8 * count);
+		}
+
+		if (left != 0)
+		{
+			words[0] = uniform_bits<uint64_t>(engine);
+			store(1, left);
+		}
+	}
+
+	/**
+	 * @brief Fill a buffer with uniformly distributed integers in `[min_val, max_val]`
+	 *
+	 * Byte-sized types over their whole range take their bytes from `fill_bytes`, all others
+	 * use `bounded_in_range`; the compile-time path produces the same values as the runtime one
+	 *
+	 * @param engine The engine to draw from
+	 * @param out The buffer to fill
+	 * @param min_val The minimum value (inclusive)
+	 * @param max_val The maximum value (inclusive)
+	 */
+	template<std::integral Int, std::uniform_random_bit_generator Engine>
+	constexpr void fill_integers(Engine& engine, std::span<Int> out, Int min_val, Int max_val)
+	{
+		if constexpr (sizeof(Int) == 1 and not std::same_as<Int, bool>)
+		{
+			if (std::min(min_val, max_val) == std::numeric_limits<Int>::lowest() and std::max(min_val, max_val) == std::numeric_limits<Int>::max())
+			{
+				if consteval
+				{
+					for (size_t i = 0; i < out.size(); i += 8)
+					{
+						uint64_t word = uniform_bits<uint64_t>(engine);
+						for (size_t j = i, end = std::min(out.size(), i + 8); j < end; ++j, word >>= 8)
+						{
+							out[j] = static_cast<Int>(static_cast<uint8_t>(word));
+						}
+					}
+				}
+				else
+				{
+					fill_bytes(engine, std::as_writable_bytes(out));
+				}
+				return;
+			}
+		}
+
+		for (Int& value : out)
+		{
+			value = bounded_in_range(engine, min_val, max_val);
+		}
+	}
+
+	/**
+	 * @brief Build a table of random integers, usable in constant expressions
+	 *
+	 * e.g. `constexpr auto salts = API_Random::make_table<uint32_t, 64>(API_Random::MinstdRand(42));`
+	 * holds the same values as `Random_t<>(42).get_array<uint32_t, 64>()`
+	 *
+	 * @tparam Int The integral type of the elements
+	 * @tparam Count The size of the table
+	 * @param engine The seeded engine to draw from (a constexpr one such as `MinstdRand` or `Philox4x32` at compile time)
+	 * @param min_val The minimum value (inclusive)
+	 * @param max_val The maximum value (inclusive)
+	 * @return The table
+	 */
+	template<std::integral Int, size_t Count, std::uniform_random_bit_generator Engine>
+	[[nodiscard]] constexpr std::array<Int, Count> make_table(Engine engine, Int min_val = std::numeric_limits<Int>::lowest(),
+															  Int max_val = std::numeric_limits<Int>::max())
+	{
+		std::array<Int, Count> table {};
+		fill_integers(engine, std::span<Int>(table), min_val, max_val);
+
+		return table;
+	}
+
+	/**
+	 * @brief Build a random permutation of `0 .. Count - 1`, usable in constant expressions
+	 *
+	 * The permutation is `shuffle` applied to the identity, i.e. what `Random_t::shuffle_range` produces for the same engine state
+	 *
+	 * @tparam T The element type (must hold `Count - 1`)
+	 * @tparam Count The size of the permutation
+	 * @param engine The seeded engine to draw from
+	 * @return The permutation
+	 */
+	template<std::integral T, size_t Count, std::uniform_random_bit_generator Engine>
+		requires(Count == 0 or Count - 1 <= static_cast<uint64_t>(std::numeric_limits<T>::max()))
+	[[nodiscard]] constexpr std::array<T, Count> make_permutation(Engine engine)
+	{
+		std::array<T, Count> permutation {};
+		for (size_t i = 0; i < Count; ++i)
+		{
+			permutation[i] = static_cast<T>(i);
+		}
+		shuffle(permutation.begin(), Count, engine);
+
+		return permutation;
+	}
+
+	/**
+	 * @brief Encode bytes as a hex string
+	 *
+	 * @param bytes The bytes to encode
+	 * @param digits The 16 digits to use (see `Charsets::hex`, `Charsets::hex_upper`)
+	 * @return Two digits per byte, high nibble first
+	 */
+	[[nodiscard]] inline std::string to_hex(std::span<const std::byte> bytes, const Charset& digits = Charsets::hex)
+	{
+		if (digits.size() != 16)
+		{
+			throw std::invalid_argument("to_hex: the charset must have 16 digits");
+		}
+
+		std::string result(2 * bytes.size(), '\0');
+		for (size_t i = 0; i < bytes.size(); ++i)
+		{
+			const auto byte = std::to_integer<uint8_t>(bytes[i]);
+			result[2 * i] = digits.view()[byte >> 4];
+			result[2 * i + 1] = digits.view()[byte & 15];
+		}
+
+		return result;
+	}
+
+	/**
+	 * @brief Encode bytes as base64 (RFC 4648)
+	 *
+	 * @param bytes The bytes to encode
+	 * @param alphabet The 64 symbols to use (see `Charsets::base64`, `Charsets::base64url`)
+	 * @param pad Whether to pad the result with '=' to a multiple of 4 characters
+	 * @return The encoded string
+	 */
+	[[nodiscard]] inline std::string to_base64(std::span<const std::byte> bytes, const Charset& alphabet = Charsets::base64, bool pad = true)
+	{
+		if (alphabet.size() != 64)
+		{
+			throw std::invalid_argument("to_base64: the charset must have 64 symbols");
+		}
+
+		const std::string_view symbols = alphabet.view();
+		std::string result;
+		result.reserve((bytes.size() + 2) / 3 * 4);
+
+		for (size_t i = 0; i < bytes.size(); i += 3)
+		{
+			const size_t count = std::min<size_t>(3, bytes.size() - i);
+
+			uint32_t group = 0;
+			for (size_t k = 0; k < 3; ++k)
+			{
+				group = group << 8 | (k < count ? std::to_integer<uint32_t>(bytes[i + k]) : 0);
+			}
+
+			for (size_t k = 0; k <= count; ++k)
+			{
+				result += symbols[(group >> (18 - 6 * k)) & 63];
+			}
+			if (pad)
+			{
+				result.append(3 - count, '=');
+			}
+		}
+
+		return result;
+	}
+
+	/**
+	 * @class WeightedSampler
+	 * @brief Weighted index selection with Walker/Vose alias tables
+	 *
+	 * Construction is O(n) and every draw is O(1): one 64-bit word picks a column and its low
+	 * product bits decide between the column and its alias. Weight changes are staged with
+	 * `set_weight`/`push_back` and applied by `rebuild`, which reuses the table storage
+	 */
+	class WeightedSampler
+	{
+	  public:
+		WeightedSampler() = default;
+
+		/**
+		 * @brief Construct a sampler from a range of non-negative weights
+		 *
+		 * @param weights The weights, at least one of them positive
+		 */
+		template<std::ranges::input_range R>
+			requires std::convertible_to<std::ranges::range_value_t<R>, double>
+		explicit WeightedSampler(R&& weights)
+		{
+			assign(std::forward<R>(weights));
+		}
+
+		/**
+		 * @brief Replace all weights and rebuild the tables
+		 *
+		 * @param weights The weights, at least one of them positive
+		 */
+		template<std::ranges::input_range R>
+			requires std::convertible_to<std::ranges::range_value_t<R>, double>
+		void assign(R&& weights)
+		{
+			m_weights.clear();
+			for (auto&& weight : weights)
+			{
+				m_weights.push_back(static_cast<double>(weight));
+			}
+			rebuild();
+		}
+
+		/**
+		 * @brief Change the weight of one index; takes effect on the next `rebuild`
+		 */
+		void set_weight(size_t idx, double weight)
+		{
+			m_weights.at(idx) = weight;
+			m_pending = true;
+		}
+
+		/**
+		 * @brief Append an index with the given weight; takes effect on the next `rebuild`
+		 */
+		void push_back(double weight)
+		{
+			m_weights.push_back(weight);
+			m_pending = true;
+		}
+
+		/**
+		 * @brief Rebuild the alias tables from the current weights in O(n)
+		 *
+		 * @throw std::invalid_argument if a weight is negative or not finite, or no weight is positive
+		 * @throw std::length_error if there are 2^32 weights or more
+		 */
+		void rebuild()
+		{
+			const size_t count = m_weights.size();
+			if (count > std::numeric_limits<uint32_t>::max())
+			{
+				throw std::length_error("WeightedSampler supports at most 2^32 - 1 weights");
+			}
+
+			double total = 0;
+			for (const double weight : m_weights)
+			{
+				if (not std::isfinite(weight) or weight < 0)
+				{
+					throw std::invalid_argument("WeightedSampler weights must be finite and non-negative");
+				}
+				total += weight;
+			}
+			if (not(total > 0))
+			{
+				throw std::invalid_argument("WeightedSampler needs at least one positive weight");
+			}
+
+			m_threshold.resize(count);
+			m_alias.resize(count);
+			m_scaled.resize(count);
+			m_small.clear();
+			m_large.clear();
+
+			for (size_t idx = 0; idx < count; ++idx)
+			{
+				m_scaled[idx] = m_weights[idx] * static_cast<double>(count) / total;
+				(m_scaled[idx] < 1 ? m_small : m_large).push_back(static_cast<uint32_t>(idx));
+			}
+
+			while (not m_small.empty() and not m_large.empty())
+			{
+				const uint32_t less = m_small.back(), more = m_large.back();
+				m_small.pop_back();
+
+				m_threshold[less] = to_threshold(m_scaled[less]);
+				m_alias[less] = more;
+
+				m_scaled[more] -= 1 - m_scaled[less];
+				if (m_scaled[more] < 1)
+				{
+					m_large.pop_back();
+					m_small.push_back(more);
+				}
+			}
+
+			// leftovers are full columns, up to rounding error
+			for (const auto& rest : { std::cref(m_small), std::cref(m_large) })
+			{
+				for (const uint32_t idx : rest.get())
+				{
+					m_threshold[idx] = std::numeric_limits<uint64_t>::max();
+					m_alias[idx] = idx;
+				}
+			}
+
+			m_pending = false;
+		}
+
+		/**
+		 * @brief Check whether staged weight changes are waiting for `rebuild`
+		 */
+		[[nodiscard]] bool needs_rebuild() const noexcept
+		{
+			return m_pending;
+		}
+
+		[[nodiscard]] size_t size() const noexcept
+		{
+			return m_threshold.size();
+		}
+
+		[[nodiscard]] std::span<const double> weights() const noexcept
+		{
+			return m_weights;
+		}
+
+		/**
+		 * @brief Draw one index with probability proportional to its weight
+		 *
+		 * @param engine The engine to draw from
+		 * @return The selected index
+		 * @pre The tables were built, i.e. the sampler holds at least one positive weight
+		 */
+		template<std::uniform_random_bit_generator Engine>
+		[[nodiscard]] size_t operator()(Engine& engine) const
+		{
+			assert(not m_threshold.empty() and "WeightedSampler used before any weights were built");
+			uint64_t coin;
+			const auto column = static_cast<size_t>(mul_64x64(uniform_bits<uint64_t>(engine), m_threshold.size(), coin));
+
+			return coin < m_threshold[column] ? column : m_alias[column];
+		}
+
+		/**
+		 * @brief Draw an index for every element of the output range
+		 *
+		 * @param engine The engine to draw from
+		 * @param out The range receiving the selected indices
+		 */
+		template<std::uniform_random_bit_generator Engine, std::ranges::output_range<size_t> R>
+		void fill(Engine& engine, R&& out) const
+		{
+			assert(not m_threshold.empty() and "WeightedSampler used before any weights were built");
+			const uint64_t count = m_threshold.size();
+			const uint64_t* const threshold = m_threshold.data();
+			const uint32_t* const alias = m_alias.data();
+
+			for (auto& dst : out)
+			{
+				uint64_t coin;
+				const auto column = static_cast<size_t>(mul_64x64(uniform_bits<uint64_t>(engine), count, coin));
+				dst = coin < threshold[column] ? column : alias[column];
+			}
+		}
+
+	  private:
+		std::vector<double> m_weights;
+		std::vector<uint64_t> m_threshold;
+		std::vector<uint32_t> m_alias;
+
+		std::vector<double> m_scaled;
+		std::vector<uint32_t> m_small, m_large;
+		bool m_pending = false;
+
+		[[nodiscard]] static uint64_t to_threshold(double probability) noexcept
+		{
+			constexpr double two_pow_64 = 18446744073709551616.0;
+
+			const double scaled = std::max(probability, 0.0) * two_pow_64;
+			return scaled >= two_pow_64 ? std::numeric_limits<uint64_t>::max() : static_cast<uint64_t>(scaled);
+		}
+	};
+
+	/**
+	 * @class SeedRegistry
+	 * @brief Process-wide source of engine seeds
+	 *
+	 * Engines are seeded from `make_stream(master_seed(), id)`, so one master seed determines every stream.
+	 * The master seed comes from a single `std::random_device` read on first use unless `set_master_seed` is called.
+	 * Under `RANDOM_STATIC` the id is the thread index; thread engines are (re)seeded lazily whenever
+	 * `stamp()` changes, i.e. after `set_master_seed`/`reseed_all` or `set_thread_index`
+	 */
+	class SeedRegistry
+	{
+	  public:
+		/**
+		 * @brief Set the master seed and make every thread engine reseed on its next use
+		 *
+		 * Instance ids restart from 0, so the unseeded instances created afterwards get the same streams on every run
+		 */
+		static void set_master_seed(uint64_t seed) noexcept
+		{
+			shared().master.store(seed, std::memory_order_relaxed);
+			shared().next_instance.store(0, std::memory_order_relaxed);
+			shared().generation.fetch_add(1, std::memory_order_release);
+		}
+
+		/**
+		 * @brief Reseed every thread engine from a fresh entropy read
+		 */
+		static void reseed_all()
+		{
+			set_master_seed(entropy());
+		}
+
+		[[nodiscard]] static uint64_t master_seed() noexcept
+		{
+			return shared().master.load(std::memory_order_relaxed);
+		}
+
+		/**
+		 * @brief Pin the stream index of the calling thread (e.g. its worker number) for reproducible pools
+		 */
+		static void set_thread_index(uint64_t index) noexcept
+		{
+			local().index = index;
+			local().has_index = true;
+			++local().version;
+		}
+
+		/**
+		 * @brief Get the stream index of the calling thread; threads without a pinned index get one in first-use order
+		 */
+		[[nodiscard]] static uint64_t thread_index() noexcept
+		{
+			if (not local().has_index)
+			{
+				local().index = shared().next_thread.fetch_add(1, std::memory_order_relaxed);
+				local().has_index = true;
+			}
+			return local().index;
+		}
+
+		/**
+		 * @brief Get a value that changes whenever the calling thread engine has to be reseeded
+		 */
+		[[nodiscard]] static uint64_t stamp() noexcept
+		{
+			return shared().generation.load(std::memory_order_acquire) + local().version;
+		}
+
+		/**
+		 * @brief Create an engine for the calling thread
+		 */
+		template<std::uniform_random_bit_generator Engine>
+		[[nodiscard]] static Engine thread_engine()
+		{
+			return make_stream<Engine>(master_seed(), thread_index());
+		}
+
+		/**
+		 * @brief Create an engine for a new generator instance; instances get consecutive ids from a separate counter
+		 */
+		template<std::uniform_random_bit_generator Engine>
+		[[nodiscard]] static Engine instance_engine()
+		{
+			return make_stream<Engine>(~master_seed(), shared().next_instance.fetch_add(1, std::memory_order_relaxed));
+		}
+
+	  private:
+		struct Shared
+		{
+			std::atomic<uint64_t> master { entropy() };
+			std::atomic<uint64_t> generation { 1 };
+			std::atomic<uint64_t> next_thread { 0 };
+			std::atomic<uint64_t> next_instance { 0 };
+		};
+
+		struct Local
+		{
+			uint64_t index = 0;
+			uint64_t version = 0;
+			bool has_index = false;
+		};
+
+		[[nodiscard]] static Shared& shared() noexcept
+		{
+			static Shared state;
+			return state;
+		}
+
+		[[nodiscard]] static Local& local() noexcept
+		{
+			thread_local Local state;
+			return state;
+		}
+
+		[[nodiscard]] static uint64_t entropy()
+		{
+			std::random_device device;
+			return uint64_t { device() } << 32 | device();
+		}
+	};
 } // namespace API_Random
 
 /**
@@ -81,52 +2483,75 @@ namespace API_Random
 template<typename RandomEngine = std::minstd_rand>
 class Random_t
 {
-	template<std::integral I>
-	using int_dist = std::uniform_int_distribution<I>;
+  private:
+#ifdef RANDOM_STATIC
+	/**
+	 * @brief Get the engine of the calling thread, reseeding it from `API_Random::SeedRegistry` when needed
+	 */
+	[[nodiscard]] static RandomEngine& engine()
+	{
+		thread_local RandomEngine rand_engine = API_Random::SeedRegistry::thread_engine<RandomEngine>();
+		thread_local uint64_t stamp = API_Random::SeedRegistry::stamp();
 
-	template<std::floating_point R>
-	using real_dist = std::uniform_real_distribution<R>;
+		if (const auto current = API_Random::SeedRegistry::stamp(); current != stamp) [[unlikely]]
+		{
+			rand_engine = API_Random::SeedRegistry::thread_engine<RandomEngine>();
+			stamp = current;
+		}
+		return rand_engine;
+	}
+#else
+	RandomEngine rand_engine = API_Random::SeedRegistry::instance_engine<RandomEngine>();
 
-  private:
-	VARIABLE_TYPE RandomEngine rand_engine { std::random_device {}() };
+	[[nodiscard]] RandomEngine& engine() noexcept
+	{
+		return rand_engine;
+	}
+#endif
 
 	/**
-	 * @brief Get the appropriate distribution for the given numeric type
+	 * @brief Generate a random number within a specified range from the given engine
 	 *
-	 * @tparam Num_Type The numeric type for which to get the distribution
-	 * @param min_val minimum value for the distribution (inclusive)
-	 * @param max_val maximum value for the distribution (inclusive)
-	 * @return A distribution object for the specified numeric type
+	 * @note No std distributions are used, see `API_Random::bounded_in_range` and `API_Random::uniform_real`
+	 * @tparam Num_Type The numeric type of the random number
+	 * @param engine The engine to draw from
+	 * @param min_val The minimum value (inclusive)
+	 * @param max_val The maximum value (inclusive for integers, exclusive for floating-point types)
+	 * @return A random number of type Num_Type in selected range
 	 */
 	template<API_Random::Numeric_Type Num_Type>
-	[[nodiscard]] constexpr AUTO_SIGNATURE get_distribution(MIN_LIMIT(Num_Type), MAX_LIMIT(Num_Type))
+	[[nodiscard]] static constexpr auto draw_in_range(auto& engine, Num_Type min_val, Num_Type max_val) -> Num_Type
 	{
-		if constexpr (std::is_floating_point_v<Num_Type>)
-		{
-			return real_dist<Num_Type> { min_val, max_val };
-		}
-		else if constexpr (sizeof(Num_Type) == 1)
+		if constexpr (std::is_integral_v<Num_Type>)
 		{
-			return int_dist<int16_t> { min_val, max_val }; // cant use 1 byte types on msvc
+			return API_Random::bounded_in_range(engine, min_val, max_val);
 		}
 		else
 		{
-			return int_dist<Num_Type> { min_val, max_val };
+			return API_Random::uniform_real(engine, min_val, max_val);
 		}
 	}
 
   public:
-	using seed_t = std::decay_t<decltype(decltype(rand_engine)::default_seed)>;
+	using seed_t = std::decay_t<decltype(RandomEngine::default_seed)>;
 
 	/**
 	 * @brief Constructor with a seed
 	 *
+	 * @note The engine is seeded directly, without taking an instance id from `API_Random::SeedRegistry`
 	 * @param seed The seed for the random number generator
 	 */
+#ifdef RANDOM_STATIC
+	explicit Random_t(seed_t seed)
+	{
+		engine().seed(seed);
+	}
+#else
 	explicit Random_t(seed_t seed)
+		: rand_engine(seed)
 	{
-		rand_engine.seed(seed);
 	}
+#endif
 
 	Random_t() = default;
 	Random_t(Random_t&&) noexcept = default;
@@ -140,22 +2565,24 @@ class Random_t
 	/**
 	 * @brief Generate a random number within a specified range
 	 *
+	 * @note Integers use the nearly-divisionless bounded method and floating-point values are built from raw bits;
+	 * both are bit-exact across platforms for a given seed. For floating-point types `max_val` is exclusive
 	 * @tparam Num_Type The numeric type of the random number
 	 * @param min_val The minimum value (inclusive)
-	 * @param max_val The maximum value (inclusive)
+	 * @param max_val The maximum value (inclusive for integers, exclusive for floating-point types)
 	 * @return A random number of type Num_Type in selected range
 	 */
 	template<API_Random::Numeric_Type Num_Type>
 	[[nodiscard]] AUTO_SIGNATURE in_range(MIN_LIMIT(Num_Type), MAX_LIMIT(Num_Type)) -> Num_Type
 	{
-		return static_cast<Num_Type>(get_distribution(min_val, max_val)(rand_engine));
+		return draw_in_range(engine(), min_val, max_val);
 	}
 
 	/**
 	 * @brief Generate a random number from zero to a specified maximum
 	 *
 	 * @tparam Num_Type The numeric type of the random number
-	 * @param max_val The maximum value (inclusive)
+	 * @param max_val The maximum value (inclusive for integers, exclusive for floating-point types)
 	 * @return A random number of type Num_Type
 	 */
 	template<API_Random::Numeric_Type Num_Type>
@@ -164,6 +2591,81 @@ class Random_t
 		return in_range<Num_Type>({}, max_val);
 	}
 
+	/**
+	 * @brief Draw a value from a distribution (see `API_Random::Normal`, `Exponential`, `LogNormal`, `Gamma`, `Poisson`)
+	 *
+	 * @param dist The distribution with its parameters
+	 * @return A random value of the distribution result type
+	 */
+	template<API_Random::Distribution D>
+	[[nodiscard]] AUTO_SIGNATURE draw(const D& dist) -> typename D::result_type
+	{
+		return dist(engine());
+	}
+
+	/**
+	 * @brief Generate a normally distributed value
+	 *
+	 * @param mean The mean of the distribution
+	 * @param stddev The standard deviation of the distribution
+	 * @return A random value
+	 */
+	template<std::floating_point Real = double>
+	[[nodiscard]] AUTO_SIGNATURE normal(Real mean = 0, Real stddev = 1) -> Real
+	{
+		return draw(API_Random::Normal<Real> { mean, stddev });
+	}
+
+	/**
+	 * @brief Generate an exponentially distributed value
+	 *
+	 * @param lambda The rate of the distribution
+	 * @return A random value
+	 */
+	template<std::floating_point Real = double>
+	[[nodiscard]] AUTO_SIGNATURE exponential(Real lambda = 1) -> Real
+	{
+		return draw(API_Random::Exponential<Real> { lambda });
+	}
+
+	/**
+	 * @brief Generate a log-normally distributed value
+	 *
+	 * @param m The mean of the underlying normal distribution
+	 * @param s The standard deviation of the underlying normal distribution
+	 * @return A random value
+	 */
+	template<std::floating_point Real = double>
+	[[nodiscard]] AUTO_SIGNATURE lognormal(Real m = 0, Real s = 1) -> Real
+	{
+		return draw(API_Random::LogNormal<Real> { m, s });
+	}
+
+	/**
+	 * @brief Generate a gamma distributed value
+	 *
+	 * @param shape The shape of the distribution (positive)
+	 * @param scale The scale of the distribution (positive)
+	 * @return A random value
+	 */
+	template<std::floating_point Real = double>
+	[[nodiscard]] AUTO_SIGNATURE gamma(Real shape = 1, Real scale = 1) -> Real
+	{
+		return draw(API_Random::Gamma<Real> { shape, scale });
+	}
+
+	/**
+	 * @brief Generate a Poisson distributed value
+	 *
+	 * @param mean The mean of the distribution
+	 * @return A random count
+	 */
+	template<std::integral Int = int64_t>
+	[[nodiscard]] AUTO_SIGNATURE poisson(double mean = 1) -> Int
+	{
+		return draw(API_Random::Poisson<Int> { mean });
+	}
+
 	/**
 	 * @brief Generate a random boolean value
 	 *
@@ -171,7 +2673,14 @@ class Random_t
 	 */
 	[[nodiscard]] AUTO_SIGNATURE get_bool() -> bool
 	{
-		return in_range<bool>();
+		if constexpr (requires { engine().next_bool(); })
+		{
+			return engine().next_bool();
+		}
+		else
+		{
+			return in_range<bool>();
+		}
 	}
 
 	/**
@@ -182,7 +2691,7 @@ class Random_t
 	 */
 	[[nodiscard]] AUTO_SIGNATURE chance_probability(double prob) -> bool
 	{
-		return std::bernoulli_distribution { std::clamp<double>(prob, 0, 1) }(rand_engine);
+		return API_Random::canonical<double>(engine()) < std::clamp<double>(prob, 0, 1);
 	}
 
 	/**
@@ -202,30 +2711,175 @@ class Random_t
 	 * @tparam R The type of the range
 	 * @param range The range from which to select an element
 	 * @return A random element from the range
+	 * @pre The range is not empty
 	 */
 	[[nodiscard]] AUTO_SIGNATURE get_elem(std::ranges::range auto&& range)
 	{
 		auto it = std::ranges::begin(range);
 		const auto last_idx = std::ranges::distance(range) - 1;
+		assert(last_idx >= 0 and "get_elem needs a non-empty range");
 		std::ranges::advance(it, from_zero_to(last_idx));
 
 		return *it;
 	}
 
+	/**
+	 * @brief Get a random index chosen with a weighted sampler
+	 *
+	 * @param sampler The sampler holding the weights
+	 * @return An index in `[0, sampler.size())`, chosen proportionally to its weight
+	 */
+	[[nodiscard]] AUTO_SIGNATURE get_weighted_index(const API_Random::WeightedSampler& sampler) -> size_t
+	{
+		return sampler(engine());
+	}
+
+	/**
+	 * @brief Get a random element from a given range, chosen with a weighted sampler
+	 *
+	 * @param range The range from which to select an element (at least `sampler.size()` elements)
+	 * @param sampler The sampler holding the weight of every element
+	 * @return A random element from the range
+	 * @pre The range has at least `sampler.size()` elements
+	 */
+	[[nodiscard]] AUTO_SIGNATURE get_elem(std::ranges::range auto&& range, const API_Random::WeightedSampler& sampler)
+	{
+		auto it = std::ranges::begin(range);
+		const auto end = std::ranges::end(range);
+		[[maybe_unused]] const auto missing =
+			std::ranges::advance(it, static_cast<std::ranges::range_difference_t<decltype(range)>>(sampler(engine())), end);
+		assert(missing == 0 and it != end and "get_elem needs a range with at least sampler.size() elements");
+
+		return *it;
+	}
+
+	/**
+	 * @brief Fill a range with weighted random indices
+	 *
+	 * @param range The range to fill
+	 * @param sampler The sampler holding the weights
+	 */
+	AUTO_SIGNATURE fill_weighted(std::ranges::output_range<size_t> auto&& range, const API_Random::WeightedSampler& sampler) -> void
+	{
+		sampler.fill(engine(), range);
+	}
+
 	/**
 	 * @brief Fill a range with random numeric values within specified limits
 	 *
+	 * @note Contiguous ranges use `API_Random::fill_integers`/`fill_uniform_real`; byte-sized types over the whole type range are filled with `fill_bytes`
+	 * @note The values differ from the execution policy overload for the same seed, which draws from derived streams:
+	 * bounded draws reject a variable number of words, so no policy-independent split of this single stream exists
 	 * @tparam R The type of the range
 	 * @tparam T The type of the elements in the range
 	 * @param range The range to fill
 	 * @param min_val The minimum value (inclusive)
-	 * @param max_val The maximum value (inclusive)
+	 * @param max_val The maximum value (inclusive for integers, exclusive for floating-point types)
 	 */
 	template<std::ranges::range R, typename T = std::ranges::range_value_t<R>>
 		requires API_Random::Numeric_Type<T>
 	AUTO_SIGNATURE fill_range(R& range, MIN_LIMIT(T), MAX_LIMIT(T)) -> void
 	{
-		std::ranges::generate(range, [&] { return in_range(min_val, max_val); });
+		if constexpr (std::is_floating_point_v<T> && std::ranges::contiguous_range<R>)
+		{
+			API_Random::fill_uniform_real(engine(), std::span<T>(std::ranges::data(range), std::ranges::size(range)), min_val, max_val);
+		}
+		else if constexpr (std::is_integral_v<T> && std::ranges::contiguous_range<R>)
+		{
+			API_Random::fill_integers(engine(), std::span<T>(std::ranges::data(range), std::ranges::size(range)), min_val, max_val);
+		}
+		else
+		{
+			std::ranges::generate(range, [&] { return in_range(min_val, max_val); });
+		}
+	}
+
+	/**
+	 * @brief Fill a range with values drawn from a distribution
+	 *
+	 * @note Contiguous ranges of the distribution result type use its bulk kernel
+	 * @tparam R The type of the range
+	 * @tparam D The type of the distribution
+	 * @param range The range to fill
+	 * @param dist The distribution with its parameters
+	 */
+	template<std::ranges::range R, API_Random::Distribution D>
+	AUTO_SIGNATURE fill_range(R& range, const D& dist) -> void
+	{
+		using Value = typename D::result_type;
+
+		if constexpr (std::ranges::contiguous_range<R> && std::same_as<std::ranges::range_value_t<R>, Value>)
+		{
+			dist.fill(engine(), std::span<Value>(std::ranges::data(range), std::ranges::size(range)));
+		}
+		else
+		{
+			std::ranges::generate(range, [&] { return dist(engine()); });
+		}
+	}
+
+	/**
+	 * @brief Fill a random access range with random numeric values using an execution policy
+	 *
+	 * One key is drawn from the engine; every block of `API_Random::stream_block_size` elements is then
+	 * generated from its own stream derived from that key. The output depends only on the engine state,
+	 * so `std::execution::par` produces exactly the values of `std::execution::seq` for a given seed
+	 *
+	 * @note It is not the output of the policy-less `fill_range` for that seed: bounded draws reject a variable
+	 * number of words, so the single stream can't be split into blocks without generating it sequentially
+	 *
+	 * @tparam ExecutionPolicy The execution policy type
+	 * @tparam R The type of the range
+	 * @tparam T The type of the elements in the range
+	 * @param policy The execution policy used to process the blocks
+	 * @param range The range to fill
+	 * @param min_val The minimum value (inclusive)
+	 * @param max_val The maximum value (inclusive for integers, exclusive for floating-point types)
+	 */
+	template<typename ExecutionPolicy, std::ranges::random_access_range R, typename T = std::ranges::range_value_t<R>>
+		requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>> && API_Random::Numeric_Type<T>
+	AUTO_SIGNATURE fill_range(ExecutionPolicy&& policy, R& range, MIN_LIMIT(T), MAX_LIMIT(T)) -> void
+	{
+		const auto key = API_Random::uniform_bits<uint64_t>(engine());
+		const auto total = static_cast<size_t>(std::ranges::distance(range));
+
+		std::vector<size_t> blocks((total + API_Random::stream_block_size - 1) / API_Random::stream_block_size);
+		std::iota(blocks.begin(), blocks.end(), size_t { 0 });
+
+		std::for_each(std::forward<ExecutionPolicy>(policy), blocks.begin(), blocks.end(), [&](size_t block) {
+			auto block_engine = API_Random::make_stream<RandomEngine>(key, block);
+
+			auto it = std::ranges::begin(range) + block * API_Random::stream_block_size;
+			const auto count = std::min(API_Random::stream_block_size, total - block * API_Random::stream_block_size);
+			for (size_t i = 0; i < count; ++i, ++it)
+			{
+				*it = draw_in_range(block_engine, min_val, max_val);
+			}
+		});
+	}
+
+	/**
+	 * @brief Advance the engine as if `count` values were drawn from it
+	 *
+	 * @param count The number of engine steps to skip
+	 */
+	AUTO_SIGNATURE jump(unsigned long long count) -> void
+	{
+		API_Random::jump(engine(), count);
+	}
+
+	/**
+	 * @brief Reseed the engine with an independent numbered stream
+	 *
+	 * Streams are derived from a shared key, so workers that each select their own stream id
+	 * produce reproducible, non-overlapping sequences for a given key
+	 *
+	 * @param key The key shared by the streams (e.g. drawn once with `in_range<uint64_t>()`)
+	 * @param stream_id The index of the stream
+	 */
+	AUTO_SIGNATURE seed_stream(uint64_t key, uint64_t stream_id) -> void
+	{
+		engine() = API_Random::make_stream<RandomEngine>(key, stream_id);
 	}
 
 	/**
@@ -244,8 +2898,8 @@ class Random_t
 	{
 		if constexpr (std::is_convertible_v<Gen, API_Random::StringGenPredicate>)
 		{
-			std::ranges::generate(range, [&, pred = API_Random::StringGenPredicate(std::forward(gen))] {
-				return get_string_by_pred(in_range(min_len, max_len), pred);
+			std::ranges::generate(range, [&, charset = API_Random::Charset::from_predicate(std::forward<Gen>(gen))] {
+				return get_string(in_range(min_len, max_len), charset);
 			});
 		}
 		else
@@ -285,7 +2939,7 @@ class Random_t
 	 * @tparam T The numeric type of the array elements
 	 * @tparam Count The size of the array
 	 * @param min_val The minimum value (inclusive)
-	 * @param max_val The maximum value (inclusive)
+	 * @param max_val The maximum value (inclusive for integers, exclusive for floating-point types)
 	 * @return An array of random numbers
 	 */
 	template<API_Random::Numeric_Type T, size_t Count>
@@ -314,7 +2968,7 @@ class Random_t
 		CREATE_LIMIT(Length_Type, max_str_length, max)) -> std::array<T, Count>
 	{
 		std::array<T, Count> arr;
-		fill_range(arr, min_str_length, max_str_length, std::forward(gen));
+		fill_range(arr, min_str_length, max_str_length, std::forward<decltype(gen)>(gen));
 
 		return arr;
 	}
@@ -325,7 +2979,7 @@ class Random_t
 	 * @tparam T The numeric type of the vector elements
 	 * @param size The size of the vector
 	 * @param min_val The minimum value (inclusive)
-	 * @param max_val The maximum value (inclusive)
+	 * @param max_val The maximum value (inclusive for integers, exclusive for floating-point types)
 	 * @return A vector of random numbers
 	 */
 	template<API_Random::Numeric_Type T>
@@ -337,6 +2991,44 @@ class Random_t
 		return vec;
 	}
 
+	/**
+	 * @brief Generate a vector of values drawn from a distribution
+	 *
+	 * @tparam D The type of the distribution
+	 * @param size The size of the vector
+	 * @param dist The distribution with its parameters
+	 * @return A vector of random values
+	 */
+	template<API_Random::Distribution D>
+	[[nodiscard]] AUTO_SIGNATURE get_vector(size_t size, const D& dist) -> std::vector<typename D::result_type>
+	{
+		std::vector<typename D::result_type> vec(size);
+		fill_range(vec, dist);
+
+		return vec;
+	}
+
+	/**
+	 * @brief Generate a vector of random numbers within specified limits using an execution policy
+	 *
+	 * @note The values are identical for every policy, see the parallel `fill_range` overload
+	 * @tparam T The numeric type of the vector elements
+	 * @param policy The execution policy used for generation
+	 * @param size The size of the vector
+	 * @param min_val The minimum value (inclusive)
+	 * @param max_val The maximum value (inclusive for integers, exclusive for floating-point types)
+	 * @return A vector of random numbers
+	 */
+	template<API_Random::Numeric_Type T, typename ExecutionPolicy>
+		requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+	[[nodiscard]] AUTO_SIGNATURE get_vector(ExecutionPolicy&& policy, size_t size, MIN_LIMIT(T), MAX_LIMIT(T)) -> std::vector<T>
+	{
+		std::vector<T> vec(size);
+		fill_range(std::forward<ExecutionPolicy>(policy), vec, min_val, max_val);
+
+		return vec;
+	}
+
 	/**
 	 * @brief Generate a vector of random strings based on specified criteria
 	 *
@@ -352,19 +3044,169 @@ class Random_t
 											CREATE_LIMIT(Length_Type, min_str_length, min),
 											CREATE_LIMIT(Length_Type, max_str_length, max)) -> std::vector<T>
 	{
-		std::vector<std::string> vec(size);
+		std::vector<T> vec(size);
+		fill_range(vec, min_str_length, max_str_length, std::forward<decltype(gen)>(gen));
 
 		return vec;
 	}
 
+	/**
+	 * @brief Generate a batch of random strings stored in one contiguous arena
+	 *
+	 * @tparam Length_Type The type for the length of the strings
+	 * @param count The number of strings
+	 * @param gen The chars or predicate for string generation
+	 * @param min_str_length The minimum length of the strings
+	 * @param max_str_length The maximum length of the strings
+	 * @return A batch of random strings, see `API_Random::RandomStringBatch`
+	 */
+	template<std::unsigned_integral Length_Type = uint8_t>
+	[[nodiscard]] AUTO_SIGNATURE get_string_batch(size_t count, API_Random::StringGeneraionType auto&& gen,
+												  CREATE_LIMIT(Length_Type, min_str_length, min),
+												  CREATE_LIMIT(Length_Type, max_str_length, max)) -> API_Random::RandomStringBatch
+	{
+		if constexpr (std::is_convertible_v<decltype(gen), API_Random::StringGenPredicate>)
+		{
+			const auto charset = API_Random::Charset::from_predicate(gen);
+			return API_Random::RandomStringBatch::generate(engine(), count, min_str_length, max_str_length, charset);
+		}
+		else
+		{
+			return API_Random::RandomStringBatch::generate(engine(), count, min_str_length, max_str_length, std::string_view(gen));
+		}
+	}
+
+	/**
+	 * @brief Select `count` distinct elements of a range uniformly at random
+	 *
+	 * Sized random access ranges use a sparse partial Fisher-Yates over the indices: O(count) time
+	 * and memory, and the samples come out in random order. Any other range is read once with
+	 * reservoir sampling (Algorithm L), skipping over unselected elements with geometric jumps;
+	 * the samples then come out in reservoir order
+	 *
+	 * @tparam R The type of the range
+	 * @tparam O The type of the output iterator
+	 * @param range The range to sample from
+	 * @param count The number of elements to select (fewer if the range is shorter)
+	 * @param out The output iterator receiving the samples
+	 * @return The output iterator past the last written sample
+	 */
+	template<std::ranges::input_range R, std::weakly_incrementable O>
+		requires std::indirectly_copyable<std::ranges::iterator_t<R>, O>
+	AUTO_SIGNATURE sample(R&& range, size_t count, O out) -> O
+	{
+		if (count == 0)
+		{
+			return out;
+		}
+
+		if constexpr (std::ranges::random_access_range<R> && std::ranges::sized_range<R>)
+		{
+			const auto total = static_cast<size_t>(std::ranges::size(range));
+			count = std::min(count, total);
+
+			const auto first = std::ranges::begin(range);
+			const auto at = [&](size_t idx) { return first + static_cast<std::ranges::range_difference_t<R>>(idx); };
+
+			if (count > total / 16)
+			{
+				std::vector<size_t> indices(total);
+				std::iota(indices.begin(), indices.end(), size_t { 0 });
+
+				for (size_t i = 0; i < count; ++i, ++out)
+				{
+					std::swap(indices[i], indices[API_Random::bounded_in_range(engine(), i, total - 1)]);
+					*out = *at(indices[i]);
+				}
+			}
+			else
+			{
+				// only the displaced slots of the virtual index permutation are stored
+				std::unordered_map<size_t, size_t> displaced;
+				displaced.reserve(count * 2);
+
+				for (size_t i = 0; i < count; ++i, ++out)
+				{
+					const size_t j = API_Random::bounded_in_range(engine(), i, total - 1);
+
+					const auto slot_j = displaced.find(j);
+					const size_t picked = slot_j == displaced.end() ? j : slot_j->second;
+
+					const auto slot_i = displaced.find(i);
+					displaced[j] = slot_i == displaced.end() ? i : slot_i->second;
+
+					*out = *at(picked);
+				}
+			}
+			return out;
+		}
+		else
+		{
+			using Value = std::ranges::range_value_t<R>;
+
+			auto it = std::ranges::begin(range);
+			const auto last = std::ranges::end(range);
+
+			std::vector<Value> reservoir;
+			reservoir.reserve(count);
+			for (; it != last and reservoir.size() < count; ++it)
+			{
+				reservoir.emplace_back(*it);
+			}
+
+			if (reservoir.size() == count)
+			{
+				const double inv_count = 1.0 / static_cast<double>(count);
+				double w = std::exp(std::log(API_Random::uniform_open01(engine())) * inv_count);
+
+				while (it != last)
+				{
+					const double skip = std::floor(std::log(API_Random::uniform_open01(engine())) / std::log1p(-w));
+					if (not(skip < static_cast<double>(std::numeric_limits<std::ranges::range_difference_t<R>>::max())))
+					{
+						break;
+					}
+
+					if (std::ranges::advance(it, static_cast<std::ranges::range_difference_t<R>>(skip), last) != 0 or it == last)
+					{
+						break;
+					}
+
+					reservoir[API_Random::bounded_in_range(engine(), size_t { 0 }, count - 1)] = *it;
+					++it;
+					w *= std::exp(std::log(API_Random::uniform_open01(engine())) * inv_count);
+				}
+			}
+
+			return std::ranges::move(reservoir, std::move(out)).out;
+		}
+	}
+
 	/**
 	 * @brief Shuffle the elements of a random access range
 	 *
+	 * @note Uses a batched Fisher-Yates, see `API_Random::shuffle`
 	 * @param range The range to shuffle
 	 */
 	AUTO_SIGNATURE shuffle_range(std::ranges::random_access_range auto& range) -> void
 	{
-		std::ranges::shuffle(range, rand_engine);
+		API_Random::shuffle(std::ranges::begin(range), static_cast<size_t>(std::ranges::distance(range)), engine());
+	}
+
+	/**
+	 * @brief Shuffle the elements of a random access range using an execution policy
+	 *
+	 * @note The permutation is identical for every policy, see `API_Random::parallel_shuffle`
+	 * @param policy The execution policy used for shuffling
+	 * @param range The range to shuffle
+	 */
+	template<typename ExecutionPolicy>
+		requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+	AUTO_SIGNATURE shuffle_range(ExecutionPolicy&& policy, std::ranges::random_access_range auto& range) -> void
+	{
+		const auto key = API_Random::uniform_bits<uint64_t>(engine());
+		API_Random::parallel_shuffle<RandomEngine>(std::forward<ExecutionPolicy>(policy), std::ranges::begin(range),
+												   static_cast<size_t>(std::ranges::distance(range)), key);
 	}
 
 	/**
@@ -377,7 +3219,7 @@ class Random_t
 	[[nodiscard]] AUTO_SIGNATURE get_string_from_chars(size_t str_len, const std::string_view symbols) -> std::string
 	{
 		std::string result(str_len, '\0');
-		fill_range_from(result, symbols);
+		API_Random::fill_chars(engine(), result, symbols);
 
 		return result;
 	}
@@ -391,14 +3233,75 @@ class Random_t
 	 */
 	[[nodiscard]] AUTO_SIGNATURE get_string_by_pred(size_t str_len, const API_Random::StringGenPredicate& pred) -> std::string
 	{
-		auto symbols = std::views::iota(0, 256) | std::views::filter(pred);
+		return get_string(str_len, API_Random::Charset::from_predicate(pred));
+	}
 
+	/**
+	 * @brief Generate a random string of specified length using a precomputed charset
+	 *
+	 * @param str_len The length of the string to generate
+	 * @param charset The charset to draw symbols from (see `API_Random::Charsets`)
+	 * @return A random string composed of the charset symbols
+	 */
+	[[nodiscard]] AUTO_SIGNATURE get_string(size_t str_len, const API_Random::Charset& charset) -> std::string
+	{
 		std::string result(str_len, '\0');
-		fill_range_from(result, symbols);
+		fill_chars(result, charset);
 
 		return result;
 	}
 
+	/**
+	 * @brief Fill a buffer with random symbols from a precomputed charset
+	 *
+	 * @param buffer The buffer to fill
+	 * @param charset The charset to draw symbols from (see `API_Random::Charsets`)
+	 */
+	AUTO_SIGNATURE fill_chars(std::span<char> buffer, const API_Random::Charset& charset) -> void
+	{
+		API_Random::fill_chars(engine(), buffer, charset.view());
+	}
+
+	/**
+	 * @brief Fill a buffer with random bytes
+	 *
+	 * @note Whole engine words are copied at once, see `API_Random::fill_bytes`
+	 * @param buffer The buffer to fill
+	 */
+	AUTO_SIGNATURE fill_bytes(std::span<std::byte> buffer) -> void
+	{
+		API_Random::fill_bytes(engine(), buffer);
+	}
+
+	/**
+	 * @brief Generate a random hex token, e.g. for identifiers and test payloads
+	 *
+	 * @param byte_count The number of random bytes (the token has twice as many characters)
+	 * @return The random bytes as lowercase hex
+	 */
+	[[nodiscard]] AUTO_SIGNATURE get_hex_token(size_t byte_count) -> std::string
+	{
+		std::vector<std::byte> bytes(byte_count);
+		fill_bytes(bytes);
+
+		return API_Random::to_hex(bytes);
+	}
+
+	/**
+	 * @brief Generate a random base64 token
+	 *
+	 * @param byte_count The number of random bytes
+	 * @param url_safe Whether to use the unpadded URL-safe alphabet instead of padded standard base64
+	 * @return The random bytes encoded as base64
+	 */
+	[[nodiscard]] AUTO_SIGNATURE get_base64_token(size_t byte_count, bool url_safe = true) -> std::string
+	{
+		std::vector<std::byte> bytes(byte_count);
+		fill_bytes(bytes);
+
+		return url_safe ? API_Random::to_base64(bytes, API_Random::Charsets::base64url, false) : API_Random::to_base64(bytes);
+	}
+
 	/**
 	 * @brief Generate a random alphanumeric string of specified length
 	 *
@@ -407,12 +3310,11 @@ class Random_t
 	 */
 	[[nodiscard]] AUTO_SIGNATURE get_string(size_t str_len) -> std::string
 	{
-		return get_string_by_pred(str_len, isalnum);
+		return get_string(str_len, API_Random::Charsets::alnum);
 	}
 };
 
 #undef AUTO_SIGNATURE
-#undef VARIABLE_TYPE
 #undef CREATE_LIMIT
 #undef MIN_MAX_LIMIT
 #undef MAX_LIMIT
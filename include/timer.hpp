@@ -1,14 +1,50 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cassert>
 #include <chrono>
+#include <cmath>
 #include <concepts>
+#include <cstdint>
 #include <execution>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <ranges>
+#include <span>
+#include <stdexcept>
 #include <string>
+#include <thread>
+#include <type_traits>
 #include <unordered_map>
 #include <vector>
 
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+	#define TIMER_HAS_TSC 1
+	#ifdef _MSC_VER
+		#include <intrin.h>
+	#else
+		#include <cpuid.h>
+		#include <x86intrin.h>
+	#endif
+#else
+	#define TIMER_HAS_TSC 0
+#endif
+
+#ifdef __linux__
+	#define TIMER_HAS_PERF 1
+	#include <linux/perf_event.h>
+	#include <sys/ioctl.h>
+	#include <sys/syscall.h>
+	#include <unistd.h>
+#else
+	#define TIMER_HAS_PERF 0
+#endif
+
 namespace Measurements
 {
 	using ns = std::chrono::nanoseconds;
@@ -19,14 +55,186 @@ namespace Measurements
 	using h	 = std::chrono::hours;
 } // namespace Measurements
 
+namespace _detail
+{
+	template <typename T>
+	struct is_duration : std::false_type
+	{
+	};
+
+	template <typename Rep, typename Period>
+	struct is_duration<std::chrono::duration<Rep, Period>> : std::true_type
+	{
+	};
+
+	// clocks that hand out raw ticks and convert them to durations only when asked
+	template <typename C>
+	concept TickClock = requires(uint64_t ticks) {
+		{ C::ticks() } -> std::same_as<uint64_t>;
+		{ C::to_duration(ticks) } -> std::same_as<typename C::duration>;
+		{ C::to_time_point(ticks) } -> std::same_as<typename C::time_point>;
+	};
+
+	template <typename C>
+	struct ClockTraits
+	{
+		using stamp = typename C::time_point;
+
+		[[nodiscard]] static stamp now() noexcept
+		{
+			return C::now();
+		}
+
+		[[nodiscard]] static auto elapsed(stamp from, stamp to) noexcept
+		{
+			return to - from;
+		}
+
+		[[nodiscard]] static auto to_time_point(stamp value) noexcept
+		{
+			return value;
+		}
+	};
+
+	template <TickClock C>
+	struct ClockTraits<C>
+	{
+		using stamp = uint64_t;
+
+		[[nodiscard]] static stamp now() noexcept
+		{
+			return C::ticks();
+		}
+
+		[[nodiscard]] static auto elapsed(stamp from, stamp to) noexcept
+		{
+			return C::to_duration(to - from);
+		}
+
+		[[nodiscard]] static auto to_time_point(stamp value) noexcept
+		{
+			return C::to_time_point(value);
+		}
+	};
+} // namespace _detail
+
 template <typename M>
-concept TimeMeasure_t = std::chrono::_Is_duration_v<M>;
+concept TimeMeasure_t = _detail::is_duration<M>::value;
 
-template <TimeMeasure_t M>
+class TscClock
+{
+  public:
+	using rep		 = int64_t;
+	using period	 = std::nano;
+	using duration	 = std::chrono::nanoseconds;
+	using time_point = std::chrono::time_point<TscClock>;
+
+	static constexpr bool is_steady = true;
+
+	struct Calibration
+	{
+		bool   invariant_tsc = false;
+		double ns_per_tick	 = 1.0;
+	};
+
+	[[nodiscard]] static time_point now() noexcept
+	{
+		return to_time_point(ticks());
+	}
+
+	// rdtscp on an invariant TSC, steady_clock nanoseconds everywhere else
+	[[nodiscard]] static uint64_t ticks() noexcept
+	{
+#if TIMER_HAS_TSC
+		if (calibration().invariant_tsc) [[likely]]
+		{
+			unsigned int aux;
+			return __rdtscp(&aux);
+		}
+#endif
+		return static_cast<uint64_t>(std::chrono::duration_cast<duration>(std::chrono::steady_clock::now().time_since_epoch()).count());
+	}
+
+	[[nodiscard]] static duration to_duration(uint64_t ticks) noexcept
+	{
+		return duration(static_cast<rep>(static_cast<double>(static_cast<int64_t>(ticks)) * calibration().ns_per_tick));
+	}
+
+	[[nodiscard]] static time_point to_time_point(uint64_t ticks) noexcept
+	{
+		return time_point(to_duration(ticks));
+	}
+
+	[[nodiscard]] static bool uses_tsc() noexcept
+	{
+		return calibration().invariant_tsc;
+	}
+
+	// measured once, on first use; call it at startup to keep the ~10 ms calibration out of timed code
+	static const Calibration& calibration() noexcept
+	{
+		static const Calibration value = calibrate();
+		return value;
+	}
+
+  private:
+	[[nodiscard]] static bool has_invariant_tsc() noexcept
+	{
+#if TIMER_HAS_TSC
+		unsigned int regs[4] = {};
+	#ifdef _MSC_VER
+		__cpuid(reinterpret_cast<int*>(regs), 0x80000000);
+		if (regs[0] < 0x80000007)
+			return false;
+		__cpuid(reinterpret_cast<int*>(regs), 0x80000001);
+		const bool rdtscp = (regs[3] >> 27) & 1;
+		__cpuid(reinterpret_cast<int*>(regs), 0x80000007);
+	#else
+		if (__get_cpuid_max(0x80000000, nullptr) < 0x80000007)
+			return false;
+		__get_cpuid(0x80000001, &regs[0], &regs[1], &regs[2], &regs[3]);
+		const bool rdtscp = (regs[3] >> 27) & 1;
+		__get_cpuid(0x80000007, &regs[0], &regs[1], &regs[2], &regs[3]);
+	#endif
+		return rdtscp && ((regs[3] >> 8) & 1);
+#else
+		return false;
+#endif
+	}
+
+	[[nodiscard]] static Calibration calibrate() noexcept
+	{
+		Calibration result;
+#if TIMER_HAS_TSC
+		if (!has_invariant_tsc())
+			return result;
+
+		using Steady = std::chrono::steady_clock;
+		unsigned int aux;
+
+		const auto	   steady_start = Steady::now();
+		const uint64_t tsc_start	= __rdtscp(&aux);
+		while (Steady::now() - steady_start < std::chrono::milliseconds(10))
+		{
+		}
+		const auto	   steady_stop = Steady::now();
+		const uint64_t tsc_stop	   = __rdtscp(&aux);
+
+		if (tsc_stop <= tsc_start)
+			return result;
+
+		result.invariant_tsc = true;
+		result.ns_per_tick	 = std::chrono::duration<double, std::nano>(steady_stop - steady_start).count() / static_cast<double>(tsc_stop - tsc_start);
+#endif
+		return result;
+	}
+};
+
+template <TimeMeasure_t M, typename ClockType = std::chrono::steady_clock, size_t LapCapacity = 64>
 class Timer
 {
-	using ClockType		= std::chrono::steady_clock;
-	using TimePointType = ClockType::time_point;
+	using Traits		= _detail::ClockTraits<ClockType>;
+	using TimePointType = typename Traits::stamp;
 
   public:
 	Timer()									 = default;
@@ -37,22 +245,52 @@ class Timer
 
 	[[nodiscard]] auto start_timestamp() const noexcept
 	{
-		return m_start;
+		return Traits::to_time_point(m_start);
 	}
 
 	[[nodiscard]] auto stop_timestamp() const noexcept
 	{
-		return m_stop;
+		return Traits::to_time_point(m_stop);
 	}
 
-	[[nodiscard]] auto all_timestamps() const
+	// laps since start(), converted to M on access
+	[[nodiscard]] auto laps() const noexcept
 	{
-		return m_timestamps;
+		return raw_laps() | std::views::transform([start = m_start](TimePointType lap) {
+				   return std::chrono::duration_cast<M>(Traits::elapsed(start, lap));
+			   });
+	}
+
+	[[nodiscard]] std::span<const TimePointType> raw_laps() const noexcept
+	{
+		return { m_laps.data(), m_lap_count };
+	}
+
+	// laps recorded after the store was full
+	[[nodiscard]] size_t dropped_laps() const noexcept
+	{
+		return m_dropped_laps;
+	}
+
+	[[nodiscard]] static constexpr size_t lap_capacity() noexcept
+	{
+		return LapCapacity;
+	}
+
+	[[nodiscard]] std::vector<M> all_timestamps() const
+	{
+		const auto view = laps();
+		return { view.begin(), view.end() };
+	}
+
+	[[nodiscard]] bool running() const noexcept
+	{
+		return is_running;
 	}
 
 	[[nodiscard]] auto get_duration() const noexcept
 	{
-		const auto duration = (is_running ? ClockType::now() : m_stop) - m_start;
+		const auto duration = Traits::elapsed(m_start, is_running ? Traits::now() : m_stop);
 		return std::chrono::duration<double, typename M::period>(duration);
 	}
 
@@ -60,13 +298,13 @@ class Timer
 	{
 		is_running = false;
 		m_start = m_stop = {};
-		m_timestamps.clear();
+		m_lap_count = m_dropped_laps = 0;
 	}
 
 	inline void start() noexcept
 	{
 		reset();
-		m_start	   = ClockType::now();
+		m_start	   = Traits::now();
 		is_running = true;
 	}
 
@@ -74,32 +312,414 @@ class Timer
 	{
 		if (!is_running) [[unlikely]]
 			return;
-		_make_timestamp();
-		m_stop	   = ClockType::now();
+		m_stop = Traits::now();
+		_make_timestamp(m_stop);
 		is_running = false;
 	}
 
 	inline void timestamp() noexcept
 	{
 		if (is_running)
-			_make_timestamp();
+			_make_timestamp(Traits::now());
 	}
 
   private:
-	bool		   is_running;
-	TimePointType  m_start, m_stop;
-	std::vector<M> m_timestamps;
+	bool								  is_running = false;
+	TimePointType						  m_start{}, m_stop{};
+	std::array<TimePointType, LapCapacity> m_laps;
+	size_t								  m_lap_count	 = 0;
+	size_t								  m_dropped_laps = 0;
+
+	inline void _make_timestamp(TimePointType now) noexcept
+	{
+		if (m_lap_count < LapCapacity) [[likely]]
+			m_laps[m_lap_count++] = now;
+		else
+			++m_dropped_laps;
+	}
+};
+
+// deltas of the hardware (or, without a PMU, software) counters over a region
+struct PerfCounters
+{
+	uint64_t cycles			  = 0;
+	uint64_t instructions	  = 0;
+	uint64_t cache_misses	  = 0;
+	uint64_t branch_misses	  = 0;
+	uint64_t context_switches = 0;
+	uint64_t page_faults	  = 0;
+	uint64_t task_clock_ns	  = 0;
+
+	[[nodiscard]] double ipc() const noexcept
+	{
+		return cycles ? static_cast<double>(instructions) / static_cast<double>(cycles) : 0.0;
+	}
 
-	inline void _make_timestamp()
+	PerfCounters& operator+=(const PerfCounters& other) noexcept
 	{
-		m_timestamps.emplace_back(std::chrono::duration_cast<M>(ClockType::now() - m_start));
+		cycles += other.cycles;
+		instructions += other.instructions;
+		cache_misses += other.cache_misses;
+		branch_misses += other.branch_misses;
+		context_switches += other.context_switches;
+		page_faults += other.page_faults;
+		task_clock_ns += other.task_clock_ns;
+		return *this;
+	}
+
+	[[nodiscard]] friend PerfCounters operator-(const PerfCounters& end, const PerfCounters& begin) noexcept
+	{
+		const auto delta = [](uint64_t to, uint64_t from) { return to > from ? to - from : 0; };
+		return {delta(end.cycles, begin.cycles),
+				delta(end.instructions, begin.instructions),
+				delta(end.cache_misses, begin.cache_misses),
+				delta(end.branch_misses, begin.branch_misses),
+				delta(end.context_switches, begin.context_switches),
+				delta(end.page_faults, begin.page_faults),
+				delta(end.task_clock_ns, begin.task_clock_ns)};
 	}
 };
 
+// perf_event_open counter group of the calling thread, read in one syscall;
+// falls back to software events when there is no PMU (most VMs) and reads zeros where perf is unavailable
+class PerfCounterGroup
+{
+	static constexpr size_t max_events = 7;
+
+  public:
+	PerfCounterGroup() noexcept
+	{
+#if TIMER_HAS_PERF
+		if (!open_group(true))
+			open_group(false);
+#endif
+	}
+
+	~PerfCounterGroup()
+	{
+#if TIMER_HAS_PERF
+		for (size_t i = 0; i < m_count; ++i)
+			::close(m_fds[i]);
+#endif
+	}
+
+	PerfCounterGroup(const PerfCounterGroup&)			 = delete;
+	PerfCounterGroup& operator=(const PerfCounterGroup&) = delete;
+
+	// counters count the thread that opened them, so every thread gets its own group
+	[[nodiscard]] static PerfCounterGroup& this_thread() noexcept
+	{
+		thread_local PerfCounterGroup group;
+		return group;
+	}
+
+	[[nodiscard]] bool available() const noexcept
+	{
+		return m_count > 0;
+	}
+
+	[[nodiscard]] bool hardware() const noexcept
+	{
+		return m_hardware;
+	}
+
+	// running totals, scaled up when the kernel had to multiplex the group
+	[[nodiscard]] PerfCounters read() const noexcept
+	{
+		PerfCounters result;
+#if TIMER_HAS_PERF
+		std::array<uint64_t, 3 + max_events> buffer{};
+		if (!available() || ::read(m_fds[0], buffer.data(), sizeof(buffer)) <= 0)
+			return result;
+
+		const uint64_t enabled = buffer[1];
+		const uint64_t running = buffer[2];
+		for (size_t i = 0; i < std::min<size_t>(buffer[0], m_count); ++i)
+		{
+			uint64_t value = buffer[3 + i];
+			if (running && running < enabled)
+				value = static_cast<uint64_t>(static_cast<double>(value) * static_cast<double>(enabled) / static_cast<double>(running));
+			result.*m_fields[i] = value;
+		}
+#endif
+		return result;
+	}
+
+  private:
+	std::array<int, max_events>						 m_fds{};
+	std::array<uint64_t PerfCounters::*, max_events> m_fields{};
+	size_t											 m_count	= 0;
+	bool											 m_hardware = false;
+
+#if TIMER_HAS_PERF
+	bool open(uint32_t type, uint64_t config, uint64_t PerfCounters::*field) noexcept
+	{
+		perf_event_attr attr{};
+		attr.size		 = sizeof(attr);
+		attr.type		 = type;
+		attr.config		 = config;
+		attr.disabled	 = m_count == 0;
+		attr.exclude_hv	 = 1;
+		attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+		// software events such as context switches only count kernel-side, which perf_event_paranoid may forbid
+		int fd = -1;
+		for (const bool exclude_kernel : {type == PERF_TYPE_HARDWARE, true})
+		{
+			attr.exclude_kernel = exclude_kernel;
+			fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, m_count ? m_fds[0] : -1, PERF_FLAG_FD_CLOEXEC));
+			if (fd >= 0)
+				break;
+		}
+		if (fd < 0)
+			return false;
+
+		m_fds[m_count]		= fd;
+		m_fields[m_count++] = field;
+		return true;
+	}
+
+	bool open_group(bool hardware) noexcept
+	{
+		if (hardware)
+		{
+			if (!open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, &PerfCounters::cycles))
+				return false;
+			open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, &PerfCounters::instructions);
+			open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES, &PerfCounters::cache_misses);
+			open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES, &PerfCounters::branch_misses);
+		}
+		else if (!open(PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK, &PerfCounters::task_clock_ns))
+			return false;
+
+		open(PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES, &PerfCounters::context_switches);
+		open(PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS, &PerfCounters::page_faults);
+		if (hardware)
+			open(PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK, &PerfCounters::task_clock_ns);
+
+		m_hardware = hardware;
+		ioctl(m_fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+		ioctl(m_fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+		return true;
+	}
+#endif
+};
+
 template <TimeMeasure_t M>
+struct TimerStats
+{
+	using Duration = std::chrono::duration<double, typename M::period>;
+
+	uint64_t count = 0;
+	Duration min, max, mean, stddev;
+	Duration p50, p90, p99, p999;
+};
+
+namespace _detail
+{
+	template <typename T>
+	[[nodiscard]] T load(const T& cell) noexcept
+	{
+		return cell;
+	}
+
+	template <typename T>
+	[[nodiscard]] T load(const std::atomic<T>& cell) noexcept
+	{
+		return cell.load(std::memory_order_relaxed);
+	}
+
+	template <typename T>
+	void store(T& cell, std::type_identity_t<T> value) noexcept
+	{
+		cell = value;
+	}
+
+	template <typename T>
+	void store(std::atomic<T>& cell, std::type_identity_t<T> value) noexcept
+	{
+		cell.store(value, std::memory_order_relaxed);
+	}
+} // namespace _detail
+
+// log-bucketed (HDR) histogram of nanosecond samples: exact below 256 ns, within 1/128 above,
+// fixed 58 KiB of counters, O(1) record
+// the Atomic flavour keeps a single writer but may be read and merged from other threads meanwhile
+template <bool Atomic = false>
+class BasicHdrHistogram
+{
+	template <bool>
+	friend class BasicHdrHistogram;
+
+	template <typename T>
+	using Cell = std::conditional_t<Atomic, std::atomic<T>, T>;
+
+	static constexpr int	sub_bucket_bits	 = 8;
+	static constexpr uint64_t sub_bucket_count = uint64_t{1} << sub_bucket_bits;
+	static constexpr uint64_t sub_bucket_half	 = sub_bucket_count / 2;
+	static constexpr size_t	bucket_count	 = (64 - sub_bucket_bits + 1) * sub_bucket_half + sub_bucket_half;
+
+  public:
+	void record(uint64_t value) noexcept
+	{
+		using _detail::load, _detail::store;
+
+		auto& bucket = m_counts[index_of(value)];
+		store(bucket, load(bucket) + 1);
+		store(m_min, std::min(load(m_min), value));
+		store(m_max, std::max(load(m_max), value));
+
+		const uint64_t total = load(m_total) + 1;
+		const double   delta = static_cast<double>(value) - load(m_mean);
+		const double   mean	 = load(m_mean) + delta / static_cast<double>(total);
+		store(m_m2, load(m_m2) + delta * (static_cast<double>(value) - mean));
+		store(m_mean, mean);
+		store(m_total, total);
+	}
+
+	template <typename Rep, typename Period>
+	void record(std::chrono::duration<Rep, Period> duration) noexcept
+	{
+		const auto ns = std::chrono::round<std::chrono::nanoseconds>(duration).count();
+		record(static_cast<uint64_t>(std::max<decltype(ns)>(ns, 0)));
+	}
+
+	template <bool OtherAtomic>
+	void merge(const BasicHdrHistogram<OtherAtomic>& other) noexcept
+	{
+		using _detail::load, _detail::store;
+
+		const uint64_t other_total = load(other.m_total);
+		if (other_total == 0)
+			return;
+
+		for (size_t i = 0; i < bucket_count; ++i)
+			store(m_counts[i], load(m_counts[i]) + load(other.m_counts[i]));
+
+		const uint64_t own_total = load(m_total);
+		const double   total	 = static_cast<double>(own_total + other_total);
+		const double   delta	 = load(other.m_mean) - load(m_mean);
+		store(m_m2, load(m_m2) + load(other.m_m2) + delta * delta * static_cast<double>(own_total) * static_cast<double>(other_total) / total);
+		store(m_mean, load(m_mean) + delta * static_cast<double>(other_total) / total);
+
+		store(m_total, own_total + other_total);
+		store(m_min, std::min(load(m_min), load(other.m_min)));
+		store(m_max, std::max(load(m_max), load(other.m_max)));
+	}
+
+	void reset() noexcept
+	{
+		using _detail::store;
+
+		for (auto& bucket : m_counts)
+			store(bucket, 0);
+		store(m_total, 0);
+		store(m_min, std::numeric_limits<uint64_t>::max());
+		store(m_max, 0);
+		store(m_mean, 0);
+		store(m_m2, 0);
+	}
+
+	[[nodiscard]] uint64_t count() const noexcept
+	{
+		return _detail::load(m_total);
+	}
+
+	[[nodiscard]] uint64_t min() const noexcept
+	{
+		return count() ? _detail::load(m_min) : 0;
+	}
+
+	[[nodiscard]] uint64_t max() const noexcept
+	{
+		return _detail::load(m_max);
+	}
+
+	[[nodiscard]] double mean() const noexcept
+	{
+		return _detail::load(m_mean);
+	}
+
+	[[nodiscard]] double stddev() const noexcept
+	{
+		const uint64_t total = count();
+		return total > 1 ? std::sqrt(_detail::load(m_m2) / static_cast<double>(total)) : 0.0;
+	}
+
+	// highest value of the bucket holding the given percentile, clamped to [min, max]
+	[[nodiscard]] uint64_t percentile(double percent) const noexcept
+	{
+		const uint64_t total = count();
+		if (total == 0)
+			return 0;
+
+		const auto rank = std::clamp<uint64_t>(static_cast<uint64_t>(std::ceil(percent / 100.0 * static_cast<double>(total))), 1, total);
+		uint64_t   seen = 0;
+		for (size_t i = 0; i < bucket_count; ++i)
+		{
+			if ((seen += _detail::load(m_counts[i])) >= rank)
+				return std::clamp(highest_equivalent(i), min(), std::max(min(), max()));
+		}
+		return max();
+	}
+
+	template <TimeMeasure_t M>
+	[[nodiscard]] TimerStats<M> stats() const noexcept
+	{
+		using Duration = typename TimerStats<M>::Duration;
+		const auto to  = [](double ns) { return std::chrono::duration_cast<Duration>(std::chrono::duration<double, std::nano>(ns)); };
+
+		return {count(),
+				to(static_cast<double>(min())),
+				to(static_cast<double>(max())),
+				to(mean()),
+				to(stddev()),
+				to(static_cast<double>(percentile(50))),
+				to(static_cast<double>(percentile(90))),
+				to(static_cast<double>(percentile(99))),
+				to(static_cast<double>(percentile(99.9)))};
+	}
+
+  private:
+	std::array<Cell<uint64_t>, bucket_count> m_counts{};
+	Cell<uint64_t>							 m_total = 0;
+	Cell<uint64_t>							 m_min	 = std::numeric_limits<uint64_t>::max();
+	Cell<uint64_t>							 m_max	 = 0;
+	Cell<double>							 m_mean	 = 0;
+	Cell<double>							 m_m2	 = 0;
+
+	[[nodiscard]] static constexpr size_t index_of(uint64_t value) noexcept
+	{
+		if (value < sub_bucket_count)
+			return static_cast<size_t>(value);
+
+		const int shift = std::bit_width(value) - sub_bucket_bits;
+		return static_cast<size_t>(shift * sub_bucket_half + (value >> shift));
+	}
+
+	[[nodiscard]] static constexpr uint64_t highest_equivalent(size_t index) noexcept
+	{
+		if (index < sub_bucket_count)
+			return index;
+
+		const int	   shift = static_cast<int>(index / sub_bucket_half) - 1;
+		const uint64_t sub	 = index % sub_bucket_half + sub_bucket_half;
+		return ((sub + 1) << shift) - 1;
+	}
+};
+
+using HdrHistogram = BasicHdrHistogram<>;
+
+template <TimeMeasure_t M, typename ClockType = std::chrono::steady_clock, size_t LapCapacity = 64>
+class ScopedTimer;
+
+template <TimeMeasure_t M, typename ClockType = std::chrono::steady_clock, size_t LapCapacity = 64>
+class PerfScopedTimer;
+
+template <TimeMeasure_t M, typename ClockType = std::chrono::steady_clock, size_t LapCapacity = 64>
 class BenchTimer
 {
-	using Timer_t  = Timer<M>;
+	using Timer_t  = Timer<M, ClockType, LapCapacity>;
 	using TimerMap = std::unordered_map<std::string, Timer_t>;
 
   public:
@@ -118,9 +738,63 @@ class BenchTimer
 		process_map([](auto& elem) { elem.stop(); });
 	}
 
+	// times the enclosing scope with the named timer and records the result into its histogram
+	[[nodiscard]] auto measure(const std::string& title)
+	{
+		return ScopedTimer<M, ClockType, LapCapacity>{m_timers[title], m_histograms[title]};
+	}
+
+	// like measure(), and also adds the scope's hardware counter deltas to the timer's totals
+	[[nodiscard]] auto measure_counters(const std::string& title)
+	{
+		return PerfScopedTimer<M, ClockType, LapCapacity>{m_timers[title], m_histograms[title], m_counters[title]};
+	}
+
+	void record(const std::string& title, auto duration)
+	{
+		m_histograms[title].record(duration);
+	}
+
+	[[nodiscard]] HdrHistogram& histogram(const std::string& title)
+	{
+		return m_histograms[title];
+	}
+
+	[[nodiscard]] TimerStats<M> stats(const std::string& title) const
+	{
+		const auto it = m_histograms.find(title);
+		return it != m_histograms.end() ? it->second.template stats<M>() : TimerStats<M>{};
+	}
+
+	[[nodiscard]] const auto& get_histograms() const noexcept
+	{
+		return m_histograms;
+	}
+
+	// counter totals over every measure_counters() scope; divide by stats().count for per-run figures
+	[[nodiscard]] PerfCounters counters(const std::string& title) const
+	{
+		const auto it = m_counters.find(title);
+		return it != m_counters.end() ? it->second : PerfCounters{};
+	}
+
+	[[nodiscard]] const auto& get_counters() const noexcept
+	{
+		return m_counters;
+	}
+
+	// combines the histograms of another thread or interval into this one
+	void merge(const BenchTimer& other)
+	{
+		for (const auto& [title, histogram] : other.m_histograms)
+			m_histograms[title].merge(histogram);
+		for (const auto& [title, counters] : other.m_counters)
+			m_counters[title] += counters;
+	}
+
 	void make_timestamp(const std::string& title) noexcept
 	{
-		if (auto it = m_timers.find(title); it != m_timers.end() && it->second.is_running)
+		if (auto it = m_timers.find(title); it != m_timers.end() && it->second.running())
 			it->second.timestamp();
 	}
 
@@ -132,15 +806,21 @@ class BenchTimer
 	void remove(const std::string& title) noexcept
 	{
 		m_timers.erase(title);
+		m_histograms.erase(title);
+		m_counters.erase(title);
 	}
 
 	void remove_all() noexcept
 	{
 		m_timers.clear();
+		m_histograms.clear();
+		m_counters.clear();
 	}
 
   private:
-	TimerMap m_timers;
+	TimerMap									  m_timers;
+	std::unordered_map<std::string, HdrHistogram> m_histograms;
+	std::unordered_map<std::string, PerfCounters> m_counters;
 
 	inline void process_map(auto&& func) noexcept
 	{
@@ -148,10 +828,10 @@ class BenchTimer
 	}
 };
 
-template <TimeMeasure_t M>
+template <TimeMeasure_t M, typename ClockType, size_t LapCapacity>
 class ScopedTimer
 {
-	using Timer_t = Timer<M>;
+	using Timer_t = Timer<M, ClockType, LapCapacity>;
 
   public:
 	explicit ScopedTimer(Timer_t& timer) noexcept
@@ -160,9 +840,17 @@ class ScopedTimer
 		m_timer.start();
 	}
 
+	ScopedTimer(Timer_t& timer, HdrHistogram& histogram) noexcept
+		: m_timer(timer), m_histogram(&histogram)
+	{
+		m_timer.start();
+	}
+
 	~ScopedTimer() noexcept
 	{
 		m_timer.stop();
+		if (m_histogram)
+			m_histogram->record(m_timer.get_duration());
 	}
 
 	ScopedTimer(const ScopedTimer&)			   = delete;
@@ -171,5 +859,395 @@ class ScopedTimer
 	ScopedTimer& operator=(ScopedTimer&&)	   = delete;
 
   private:
-	Timer_t& m_timer;
+	Timer_t&	  m_timer;
+	HdrHistogram* m_histogram = nullptr;
+};
+
+// ScopedTimer that also reads the thread's counter group at entry and exit and adds the deltas to `totals`
+template <TimeMeasure_t M, typename ClockType, size_t LapCapacity>
+class PerfScopedTimer
+{
+	using Timer_t = Timer<M, ClockType, LapCapacity>;
+
+  public:
+	PerfScopedTimer(Timer_t& timer, PerfCounters& totals) noexcept
+		: m_timer(timer), m_totals(totals), m_group(PerfCounterGroup::this_thread()), m_begin(m_group.read())
+	{
+		m_timer.start();
+	}
+
+	PerfScopedTimer(Timer_t& timer, HdrHistogram& histogram, PerfCounters& totals) noexcept
+		: PerfScopedTimer(timer, totals)
+	{
+		m_histogram = &histogram;
+	}
+
+	~PerfScopedTimer() noexcept
+	{
+		m_timer.stop();
+		m_totals += m_group.read() - m_begin;
+		if (m_histogram)
+			m_histogram->record(m_timer.get_duration());
+	}
+
+	PerfScopedTimer(const PerfScopedTimer&)			   = delete;
+	PerfScopedTimer& operator=(const PerfScopedTimer&) = delete;
+	PerfScopedTimer(PerfScopedTimer&&)				   = delete;
+	PerfScopedTimer& operator=(PerfScopedTimer&&)	   = delete;
+
+  private:
+	Timer_t&				m_timer;
+	PerfCounters&			m_totals;
+	const PerfCounterGroup& m_group;
+	PerfCounters			m_begin;
+	HdrHistogram*			m_histogram = nullptr;
+};
+
+// BenchTimer for many threads: every thread records into its own shard without taking a lock,
+// readers merge the shards on demand; timers are addressed by the ids handed out by id()
+template <TimeMeasure_t M, typename ClockType = std::chrono::steady_clock, size_t MaxTimers = 256>
+class ConcurrentBenchTimer
+{
+	using Traits	= _detail::ClockTraits<ClockType>;
+	using Histogram = BasicHdrHistogram<true>;
+
+	struct Shard
+	{
+		std::thread::id								   owner;
+		std::array<std::atomic<Histogram*>, MaxTimers> histograms{};
+
+		~Shard()
+		{
+			for (auto& histogram : histograms)
+				delete histogram.load(std::memory_order_relaxed);
+		}
+	};
+
+  public:
+	using Id = uint32_t;
+
+	class Measurement
+	{
+	  public:
+		explicit Measurement(Histogram& histogram) noexcept
+			: m_histogram(histogram), m_start(Traits::now())
+		{
+		}
+
+		~Measurement() noexcept
+		{
+			m_histogram.record(Traits::elapsed(m_start, Traits::now()));
+		}
+
+		Measurement(const Measurement&)			   = delete;
+		Measurement& operator=(const Measurement&) = delete;
+
+	  private:
+		Histogram&			   m_histogram;
+		typename Traits::stamp m_start;
+	};
+
+	ConcurrentBenchTimer() = default;
+
+	ConcurrentBenchTimer(const ConcurrentBenchTimer&)			 = delete;
+	ConcurrentBenchTimer& operator=(const ConcurrentBenchTimer&) = delete;
+
+	// registers the title on first use; resolve ids once, outside the measured code
+	[[nodiscard]] Id id(const std::string& title)
+	{
+		std::scoped_lock lock(m_mutex);
+		if (const auto it = std::ranges::find(m_titles, title); it != m_titles.end())
+			return static_cast<Id>(it - m_titles.begin());
+		if (m_titles.size() == MaxTimers)
+			throw std::length_error("ConcurrentBenchTimer: too many timers");
+
+		m_titles.push_back(title);
+		m_registered.store(m_titles.size(), std::memory_order_relaxed);
+		return static_cast<Id>(m_titles.size() - 1);
+	}
+
+	// times the enclosing scope into the calling thread's shard
+	[[nodiscard]] Measurement measure(Id id)
+	{
+		return Measurement{local(id)};
+	}
+
+	void record(Id id, auto duration)
+	{
+		local(id).record(duration);
+	}
+
+	// merge of every thread's samples; exact once the writers are done, approximate while they run
+	[[nodiscard]] HdrHistogram histogram(Id id) const
+	{
+		assert(id < m_registered.load(std::memory_order_relaxed) && "ConcurrentBenchTimer: id not handed out by id()");
+		HdrHistogram result;
+		std::scoped_lock lock(m_mutex);
+		for (const auto& shard : m_shards)
+		{
+			if (const Histogram* histogram = shard->histograms[id].load(std::memory_order_acquire))
+				result.merge(*histogram);
+		}
+		return result;
+	}
+
+	[[nodiscard]] TimerStats<M> stats(Id id) const
+	{
+		return histogram(id).template stats<M>();
+	}
+
+	[[nodiscard]] TimerStats<M> stats(const std::string& title) const
+	{
+		const auto id = find(title);
+		return id ? stats(*id) : TimerStats<M>{};
+	}
+
+	[[nodiscard]] std::unordered_map<std::string, TimerStats<M>> get_all() const
+	{
+		std::unordered_map<std::string, TimerStats<M>> result;
+		for (Id id = 0; const std::string& title : titles())
+			result.emplace(title, stats(id++));
+		return result;
+	}
+
+	[[nodiscard]] std::vector<std::string> titles() const
+	{
+		std::scoped_lock lock(m_mutex);
+		return m_titles;
+	}
+
+	[[nodiscard]] size_t shard_count() const
+	{
+		std::scoped_lock lock(m_mutex);
+		return m_shards.size();
+	}
+
+  private:
+	mutable std::mutex					m_mutex;
+	std::vector<std::string>			m_titles;
+	std::vector<std::unique_ptr<Shard>> m_shards;
+	std::atomic<size_t>					m_registered = 0;
+	const uint64_t						m_serial	 = next_serial();
+
+	[[nodiscard]] static uint64_t next_serial() noexcept
+	{
+		static std::atomic<uint64_t> serial = 0;
+		return serial.fetch_add(1, std::memory_order_relaxed) + 1;
+	}
+
+	[[nodiscard]] std::optional<Id> find(const std::string& title) const
+	{
+		std::scoped_lock lock(m_mutex);
+		if (const auto it = std::ranges::find(m_titles, title); it != m_titles.end())
+			return static_cast<Id>(it - m_titles.begin());
+		return std::nullopt;
+	}
+
+	// the calling thread's histogram; only the owning thread ever writes to it
+	[[nodiscard]] Histogram& local(Id id)
+	{
+		assert(id < m_registered.load(std::memory_order_relaxed) && "ConcurrentBenchTimer: id not handed out by id()");
+		auto&	   slot		 = shard().histograms[id];
+		Histogram* histogram = slot.load(std::memory_order_relaxed);
+		if (!histogram) [[unlikely]]
+		{
+			histogram = new Histogram;
+			slot.store(histogram, std::memory_order_release);
+		}
+		return *histogram;
+	}
+
+	[[nodiscard]] Shard& shard()
+	{
+		// the shards of the last few timers this thread used, replaced round-robin; serials never repeat,
+		// so the entry of a destroyed timer is never matched again and simply ages out
+		struct CachedShard
+		{
+			uint64_t serial = 0;
+			Shard*	 shard	= nullptr;
+		};
+		thread_local std::array<CachedShard, 8> cache{};
+		thread_local size_t						victim = 0;
+		for (const CachedShard& cached : cache)
+		{
+			if (cached.serial == m_serial)
+				return *cached.shard;
+		}
+
+		std::scoped_lock lock(m_mutex);
+		const auto		 owner = std::this_thread::get_id();
+		auto			 it	   = std::ranges::find(m_shards, owner, [](const auto& shard) { return shard->owner; });
+		if (it == m_shards.end())
+		{
+			m_shards.push_back(std::make_unique<Shard>());
+			m_shards.back()->owner = owner;
+			it					   = std::prev(m_shards.end());
+		}
+
+		cache[victim] = {m_serial, it->get()};
+		victim		  = (victim + 1) % cache.size();
+		return **it;
+	}
+};
+
+struct RateMeterStats
+{
+	uint64_t count	  = 0;
+	double	 mean	  = 0; // events per second since construction
+	double	 last_1s  = 0;
+	double	 last_10s = 0;
+	double	 last_60s = 0;
+	double	 ewma	  = 0;
+};
+
+// events per second from many threads: mark() is a relaxed add on the calling thread's cache-line sized stripe,
+// readers sum the stripes and keep 100 ms snapshots of the total for the sliding windows and the EWMA
+// readers serialize on a mutex; writers never block
+template <typename ClockType = std::chrono::steady_clock, size_t Stripes = 16>
+class RateMeter
+{
+	static_assert(Stripes > 0, "RateMeter needs at least one stripe");
+
+	using Traits = _detail::ClockTraits<ClockType>;
+
+	struct alignas(64) Stripe
+	{
+		std::atomic<uint64_t> count = 0;
+	};
+
+	struct Snapshot
+	{
+		typename Traits::stamp time;
+		uint64_t			   count;
+	};
+
+	static constexpr auto	bucket		  = std::chrono::milliseconds(100);
+	static constexpr size_t history_length = 1024; // ~102 s of buckets
+
+  public:
+	explicit RateMeter(std::chrono::nanoseconds ewma_time_constant = std::chrono::minutes(1))
+		: m_time_constant(std::chrono::duration<double>(ewma_time_constant).count())
+	{
+		m_history[0] = {m_start, 0};
+	}
+
+	RateMeter(const RateMeter&)			   = delete;
+	RateMeter& operator=(const RateMeter&) = delete;
+
+	void mark(uint64_t events = 1) noexcept
+	{
+		m_stripes[stripe()].count.fetch_add(events, std::memory_order_relaxed);
+	}
+
+	[[nodiscard]] uint64_t count() const noexcept
+	{
+		uint64_t total = 0;
+		for (const Stripe& stripe : m_stripes)
+			total += stripe.count.load(std::memory_order_relaxed);
+		return total;
+	}
+
+	// events per second over the trailing window (since construction while the meter is younger than that);
+	// the count at the window start is interpolated between the snapshots around it, so reads at any period give
+	// the average rate, exact to a bucket when something reads or calls update() at least every 100 ms
+	[[nodiscard]] double rate(std::chrono::nanoseconds window) const
+	{
+		std::scoped_lock lock(m_mutex);
+		return rate_locked(window, sample_locked());
+	}
+
+	[[nodiscard]] double ewma() const
+	{
+		std::scoped_lock lock(m_mutex);
+		sample_locked();
+		return m_ewma;
+	}
+
+	[[nodiscard]] RateMeterStats stats() const
+	{
+		std::scoped_lock lock(m_mutex);
+		const auto		 now	 = sample_locked();
+		const double	 seconds = std::chrono::duration<double>(Traits::elapsed(m_start, now)).count();
+		const uint64_t	 total	 = count();
+
+		return {total,
+				seconds > 0 ? static_cast<double>(total) / seconds : 0.0,
+				rate_locked(std::chrono::seconds(1), now),
+				rate_locked(std::chrono::seconds(10), now),
+				rate_locked(std::chrono::seconds(60), now),
+				m_ewma};
+	}
+
+	// takes a snapshot if a bucket has passed; call it from a periodic task when reads are rare
+	void update() const
+	{
+		std::scoped_lock lock(m_mutex);
+		sample_locked();
+	}
+
+  private:
+	std::array<Stripe, Stripes>				  m_stripes;
+	mutable std::mutex						  m_mutex;
+	mutable std::array<Snapshot, history_length> m_history{};
+	mutable size_t							  m_newest	 = 0;
+	mutable size_t							  m_recorded = 1;
+	mutable double							  m_ewma	 = 0;
+	mutable bool							  m_primed	 = false;
+	const double							  m_time_constant;
+	const typename Traits::stamp			  m_start = Traits::now();
+
+	// threads take stripes round-robin on first use
+	[[nodiscard]] static size_t stripe() noexcept
+	{
+		static std::atomic<size_t> next = 0;
+		thread_local const size_t  index = next.fetch_add(1, std::memory_order_relaxed) % Stripes;
+		return index;
+	}
+
+	typename Traits::stamp sample_locked() const
+	{
+		const auto		now		= Traits::now();
+		const Snapshot& newest	= m_history[m_newest];
+		const auto		elapsed = Traits::elapsed(newest.time, now);
+		if (elapsed < bucket)
+			return now;
+
+		const uint64_t total   = count();
+		const double   seconds = std::chrono::duration<double>(elapsed).count();
+		const double   rate	   = static_cast<double>(total - newest.count) / seconds;
+		m_ewma				   = m_primed ? m_ewma + (1 - std::exp(-seconds / m_time_constant)) * (rate - m_ewma) : rate;
+		m_primed			   = true;
+
+		m_newest			= (m_newest + 1) % history_length;
+		m_history[m_newest] = {now, total};
+		m_recorded			= std::min(m_recorded + 1, history_length);
+		return now;
+	}
+
+	[[nodiscard]] double rate_locked(std::chrono::nanoseconds window, typename Traits::stamp now) const noexcept
+	{
+		const double span = std::chrono::duration<double>(window).count();
+		if (span <= 0)
+			return 0.0;
+
+		// walk back from the live count to the first snapshot at least `window` old
+		const double total		   = static_cast<double>(count());
+		double		 younger_age   = 0;
+		double		 younger_count = total;
+		for (size_t index = 0; index < m_recorded; ++index)
+		{
+			const Snapshot& snapshot = m_history[(m_newest + history_length - index) % history_length];
+			const double	age		 = std::chrono::duration<double>(Traits::elapsed(snapshot.time, now)).count();
+			if (age >= span)
+			{
+				const double weight = age > younger_age ? (span - younger_age) / (age - younger_age) : 0.0;
+				return (total - (younger_count + weight * (static_cast<double>(snapshot.count) - younger_count))) / span;
+			}
+			younger_age	  = age;
+			younger_count = static_cast<double>(snapshot.count);
+		}
+
+		// younger than the window: the rate since the oldest snapshot kept
+		return younger_age > 0 ? (total - younger_count) / younger_age : 0.0;
+	}
 };
\ No newline at end of file
@@ -0,0 +1,439 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "timer.hpp"
+
+// hierarchical hashed timing wheel: 4 levels of 256 slots, O(1) schedule and cancel,
+// expiries rounded up to whole ticks of `Resolution` and delays past 2^32 ticks re-cascaded from the top level
+// not thread safe; see TimingWheelRunner for a locked wheel driven by its own thread
+template <TimeMeasure_t Resolution, typename ClockType>
+class TimingWheelRunner;
+
+template <TimeMeasure_t Resolution = Measurements::ms, typename ClockType = std::chrono::steady_clock>
+class TimingWheel
+{
+	friend class TimingWheelRunner<Resolution, ClockType>;
+
+	using Traits = _detail::ClockTraits<ClockType>;
+
+	static constexpr int	  slot_bits	 = 8;
+	static constexpr size_t	  slots		 = size_t{1} << slot_bits;
+	static constexpr size_t	  slot_mask	 = slots - 1;
+	static constexpr size_t	  levels	 = 4;
+	static constexpr uint64_t max_delta	 = (uint64_t{1} << (slot_bits * levels)) - 1;
+	static constexpr uint32_t npos		 = std::numeric_limits<uint32_t>::max();
+
+	enum class State : uint8_t
+	{
+		free,
+		linked,
+		due
+	};
+
+	struct Node
+	{
+		std::function<void()> callback;
+		uint64_t			  when		 = 0;
+		uint64_t			  period	 = 0;
+		uint32_t			  prev		 = npos;
+		uint32_t			  next		 = npos;
+		uint32_t			  generation = 0;
+		uint16_t			  slot		 = 0;
+		State				  state		 = State::free;
+	};
+
+	using Bitmap = std::array<uint64_t, slots / 64>;
+
+  public:
+	using Callback = std::function<void()>;
+
+	struct Handle
+	{
+		uint32_t index		= npos;
+		uint32_t generation = 0;
+
+		explicit operator bool() const noexcept
+		{
+			return index != npos;
+		}
+	};
+
+	TimingWheel()
+	{
+		m_heads.fill(npos);
+	}
+
+	TimingWheel(const TimingWheel&)			   = delete;
+	TimingWheel& operator=(const TimingWheel&) = delete;
+
+	// fires once, `delay` (at least one tick) from now: from the wheel's current time while it is driven by tick(),
+	// from the clock rounded up to the next tick once it is driven by poll(), so a timer never fires early
+	template <typename Rep, typename Period>
+	Handle schedule(std::chrono::duration<Rep, Period> delay, Callback callback)
+	{
+		return add(to_ticks(delay), 0, std::move(callback));
+	}
+
+	// fires every `period` until cancelled; late polls don't accumulate drift
+	template <typename Rep, typename Period>
+	Handle schedule_every(std::chrono::duration<Rep, Period> period, Callback callback)
+	{
+		const uint64_t ticks = to_ticks(period);
+		return add(ticks, ticks, std::move(callback));
+	}
+
+	// false if the timer already fired (one-shot), was cancelled or the handle is empty
+	bool cancel(Handle handle) noexcept
+	{
+		if (handle.index >= m_nodes.size() || m_nodes[handle.index].generation != handle.generation)
+			return false;
+
+		Node& node = m_nodes[handle.index];
+		if (node.state == State::linked)
+			unlink(handle.index);
+		else if (node.state != State::due)
+			return false;
+
+		release(handle.index);
+		return true;
+	}
+
+	// tick-driven: moves the wheel `ticks` forward and runs what expired, returns the number of callbacks run
+	size_t tick(uint64_t ticks = 1)
+	{
+		m_clock_driven = false;
+		return advance_to(m_now + ticks);
+	}
+
+	// clock-driven: catches the wheel up with ClockType
+	size_t poll()
+	{
+		m_clock_driven = true;
+		return advance_to(clock_ticks());
+	}
+
+	// time until the wheel next has work: an expiry or a cascade, so never later than the earliest timer
+	[[nodiscard]] std::optional<Resolution> next_expiry() const noexcept
+	{
+		if (m_size == 0)
+			return std::nullopt;
+		return Resolution(static_cast<typename Resolution::rep>(next_event_offset()));
+	}
+
+	[[nodiscard]] uint64_t now_ticks() const noexcept
+	{
+		return m_now;
+	}
+
+	[[nodiscard]] size_t size() const noexcept
+	{
+		return m_size;
+	}
+
+	[[nodiscard]] bool empty() const noexcept
+	{
+		return m_size == 0;
+	}
+
+  private:
+	std::vector<Node>						  m_nodes;
+	std::vector<std::pair<uint32_t, uint32_t>> m_due;
+	std::array<uint32_t, levels * slots>	  m_heads;
+	std::array<Bitmap, levels>				  m_occupied{};
+	uint32_t								  m_free         = npos;
+	size_t									  m_size         = 0;
+	uint64_t								  m_now          = 0;
+	bool									  m_clock_driven = false;
+	typename Traits::stamp					  m_origin       = Traits::now();
+
+	// whole ticks of ClockType since construction; the wheel's own time lags behind it until the next poll()
+	[[nodiscard]] uint64_t clock_ticks() const noexcept
+	{
+		const auto elapsed = std::chrono::floor<Resolution>(Traits::elapsed(m_origin, Traits::now())).count();
+		return static_cast<uint64_t>(std::max<decltype(elapsed)>(elapsed, 0));
+	}
+
+	// the same rounded up, the tick a delay has to be counted from for the expiry not to come early
+	[[nodiscard]] uint64_t clock_ticks_ceil() const noexcept
+	{
+		const auto elapsed = std::chrono::ceil<Resolution>(Traits::elapsed(m_origin, Traits::now())).count();
+		return static_cast<uint64_t>(std::max<decltype(elapsed)>(elapsed, 0));
+	}
+
+	template <typename Rep, typename Period>
+	[[nodiscard]] static uint64_t to_ticks(std::chrono::duration<Rep, Period> delay) noexcept
+	{
+		const auto ticks = std::chrono::ceil<Resolution>(delay).count();
+		return static_cast<uint64_t>(std::max<decltype(ticks)>(ticks, 1));
+	}
+
+	Handle add(uint64_t delay, uint64_t period, Callback callback)
+	{
+		uint32_t index = m_free;
+		if (index != npos)
+			m_free = m_nodes[index].next;
+		else
+		{
+			index = static_cast<uint32_t>(m_nodes.size());
+			m_nodes.emplace_back();
+		}
+
+		Node& node	   = m_nodes[index];
+		node.callback  = std::move(callback);
+		node.when	   = (m_clock_driven ? std::max(clock_ticks_ceil(), m_now) : m_now) + delay;
+		node.period	   = period;
+		++m_size;
+		link(index);
+		return {index, node.generation};
+	}
+
+	void release(uint32_t index) noexcept
+	{
+		Node& node	  = m_nodes[index];
+		node.callback = nullptr;
+		node.state	  = State::free;
+		node.next	  = m_free;
+		++node.generation;
+		m_free = index;
+		--m_size;
+	}
+
+	// slot of the lowest level whose span covers the remaining delay
+	void link(uint32_t index) noexcept
+	{
+		Node&		   node	 = m_nodes[index];
+		const uint64_t delta = std::min(node.when > m_now ? node.when - m_now : 0, max_delta);
+		const size_t   level = delta < slots ? 0 : static_cast<size_t>(std::bit_width(delta) - 1) / slot_bits;
+		const size_t   slot	 = ((m_now + delta) >> (level * slot_bits)) & slot_mask;
+
+		node.slot  = static_cast<uint16_t>(level * slots + slot);
+		node.state = State::linked;
+		node.prev  = npos;
+		node.next  = m_heads[node.slot];
+		if (node.next != npos)
+			m_nodes[node.next].prev = index;
+		m_heads[node.slot] = index;
+		m_occupied[level][slot / 64] |= uint64_t{1} << (slot % 64);
+	}
+
+	void unlink(uint32_t index) noexcept
+	{
+		const Node& node = m_nodes[index];
+		if (node.prev != npos)
+			m_nodes[node.prev].next = node.next;
+		else
+			m_heads[node.slot] = node.next;
+		if (node.next != npos)
+			m_nodes[node.next].prev = node.prev;
+
+		if (m_heads[node.slot] == npos)
+			clear_bit(node.slot);
+	}
+
+	void clear_bit(size_t slot) noexcept
+	{
+		m_occupied[slot / slots][(slot % slots) / 64] &= ~(uint64_t{1} << (slot % 64));
+	}
+
+	// detaches a whole slot and hands each timer to `func`
+	void drain(size_t slot, auto&& func)
+	{
+		uint32_t index = std::exchange(m_heads[slot], npos);
+		clear_bit(slot);
+		while (index != npos)
+			func(std::exchange(index, m_nodes[index].next));
+	}
+
+	// distance in slots (1 .. 256) from `from` to the next occupied slot after it, 0 for an empty level
+	[[nodiscard]] static size_t next_occupied(const Bitmap& bits, size_t from) noexcept
+	{
+		for (size_t step = 1; step <= slots;)
+		{
+			const size_t   index = (from + step) & slot_mask;
+			const uint64_t word	 = bits[index / 64] >> (index % 64);
+			if (word)
+				return step + static_cast<size_t>(std::countr_zero(word));
+			step += 64 - index % 64;
+		}
+		return 0;
+	}
+
+	// ticks to the next level-0 expiry or the next cascade of a non-empty slot
+	[[nodiscard]] uint64_t next_event_offset() const noexcept
+	{
+		uint64_t best = std::numeric_limits<uint64_t>::max();
+		for (size_t level = 0; level < levels; ++level)
+		{
+			const int	   shift = static_cast<int>(level) * slot_bits;
+			const uint64_t base	 = m_now >> shift;
+			if (const size_t offset = next_occupied(m_occupied[level], base & slot_mask))
+				best = std::min(best, ((base + offset) << shift) - m_now);
+		}
+		return best;
+	}
+
+	size_t advance_to(uint64_t target)
+	{
+		size_t fired = 0;
+		while (m_now < target)
+		{
+			// ticks in between have nothing to expire or cascade, so skip them
+			const uint64_t offset = m_size ? next_event_offset() : std::numeric_limits<uint64_t>::max();
+			if (offset > target - m_now)
+			{
+				m_now = target;
+				break;
+			}
+
+			m_now += offset;
+			cascade();
+			fired += expire();
+		}
+		return fired;
+	}
+
+	// at each level boundary, re-hashes the upper level's current slot into the levels below
+	void cascade()
+	{
+		for (size_t level = 1; level < levels; ++level)
+		{
+			const int shift = static_cast<int>(level) * slot_bits;
+			if (m_now & ((uint64_t{1} << shift) - 1))
+				break;
+			drain(level * slots + ((m_now >> shift) & slot_mask), [&](uint32_t index) { link(index); });
+		}
+	}
+
+	size_t expire()
+	{
+		// taken out of the member so a callback that advances the wheel again can't clobber it
+		auto due = std::exchange(m_due, {});
+		due.clear();
+		drain(m_now & slot_mask, [&](uint32_t index) {
+			m_nodes[index].state = State::due;
+			due.emplace_back(index, m_nodes[index].generation);
+		});
+
+		size_t fired = 0;
+		for (const auto& [index, generation] : due)
+		{
+			// an earlier callback may have cancelled this one
+			if (m_nodes[index].generation != generation || m_nodes[index].state != State::due)
+				continue;
+
+			Callback callback = std::move(m_nodes[index].callback);
+			if (const uint64_t period = m_nodes[index].period)
+			{
+				m_nodes[index].when = std::max(m_nodes[index].when + period, m_now + 1);
+				link(index);
+				callback();
+				// still armed unless the callback cancelled it
+				if (m_nodes[index].generation == generation)
+					m_nodes[index].callback = std::move(callback);
+			}
+			else
+			{
+				release(index);
+				callback();
+			}
+			++fired;
+		}
+
+		if (due.capacity() > m_due.capacity())
+			m_due = std::move(due);
+		return fired;
+	}
+};
+
+// TimingWheel polled by a background thread that sleeps until the next expiry;
+// callbacks run on that thread and may schedule or cancel timers themselves
+template <TimeMeasure_t Resolution = Measurements::ms, typename ClockType = std::chrono::steady_clock>
+class TimingWheelRunner
+{
+	using Wheel = TimingWheel<Resolution, ClockType>;
+
+  public:
+	using Handle   = typename Wheel::Handle;
+	using Callback = typename Wheel::Callback;
+
+	TimingWheelRunner()
+	{
+		// delays count from the clock even before the thread's first poll()
+		m_wheel.m_clock_driven = true;
+		m_thread			   = std::jthread([this](std::stop_token stop) { run(stop); });
+	}
+
+	TimingWheelRunner(const TimingWheelRunner&)			   = delete;
+	TimingWheelRunner& operator=(const TimingWheelRunner&) = delete;
+
+	template <typename Rep, typename Period>
+	Handle schedule(std::chrono::duration<Rep, Period> delay, Callback callback)
+	{
+		return add(Wheel::to_ticks(delay), 0, std::move(callback));
+	}
+
+	template <typename Rep, typename Period>
+	Handle schedule_every(std::chrono::duration<Rep, Period> period, Callback callback)
+	{
+		const uint64_t ticks = Wheel::to_ticks(period);
+		return add(ticks, ticks, std::move(callback));
+	}
+
+	bool cancel(Handle handle)
+	{
+		std::scoped_lock lock(m_mutex);
+		return m_wheel.cancel(handle);
+	}
+
+	[[nodiscard]] size_t size() const
+	{
+		std::scoped_lock lock(m_mutex);
+		return m_wheel.size();
+	}
+
+  private:
+	// recursive so callbacks, which run under the lock, can reschedule
+	mutable std::recursive_mutex m_mutex;
+	std::condition_variable_any	 m_wakeup;
+	bool						 m_changed = false;
+	Wheel						 m_wheel;
+	std::jthread				 m_thread;
+
+	Handle add(uint64_t delay, uint64_t period, Callback callback)
+	{
+		std::scoped_lock lock(m_mutex);
+		// the wheel is clock-driven, so the delay counts from the clock rather than from the last poll()
+		const Handle handle = m_wheel.add(delay, period, std::move(callback));
+		m_changed			= true;
+		m_wakeup.notify_one();
+		return handle;
+	}
+
+	void run(std::stop_token stop)
+	{
+		std::unique_lock lock(m_mutex);
+		while (!stop.stop_requested())
+		{
+			m_wheel.poll();
+			const auto changed = [&] { return std::exchange(m_changed, false); };
+			if (const auto next = m_wheel.next_expiry())
+				m_wakeup.wait_for(lock, stop, *next, changed);
+			else
+				m_wakeup.wait(lock, stop, changed);
+		}
+	}
+};
@@ -0,0 +1,185 @@
+// Tests for include/bench.hpp
+//
+// build e.g. g++ -std=c++23 -O2 -pthread bench_test.cpp
+//         or cl /std:c++latest /O2 /EHsc bench_test.cpp
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../include/bench.hpp"
+#include "check.hpp"
+
+static Bench::Result make_result(std::string name, double first_ns, size_t count) {
+    Bench::Result result;
+    result.name = std::move(name);
+    result.iterations = 1000;
+    result.samples = count;
+    for (size_t i = 0; i < count; ++i) {
+        result.samples_ns.push_back(first_ns + static_cast<double>(i));
+    }
+    result.ns_per_op = first_ns + static_cast<double>(count - 1) / 2;
+    result.median_ns = result.ns_per_op;
+    result.min_ns = result.samples_ns.front();
+    result.max_ns = result.samples_ns.back();
+    result.stddev_ns = std::sqrt(static_cast<double>(count * (count + 1)) / 12.0);
+    return result;
+}
+
+static bool near(double a, double b, double tolerance) {
+    return std::abs(a - b) <= tolerance;
+}
+
+static void test_mann_whitney() {
+    // 30 samples entirely above 30 others: U = 900, z = (900 - 450) / sqrt(30 * 30 * 61 / 12)
+    const auto slow = make_result("x", 101, 30), fast = make_result("x", 1, 30);
+    const auto [z, significant] = Bench::_detail::mann_whitney(fast.samples_ns, slow.samples_ns);
+    CHECK(near(z, 450 / std::sqrt(4575.0), 1e-9));
+    CHECK(significant);
+
+    const auto [z_faster, faster_significant] = Bench::_detail::mann_whitney(slow.samples_ns, fast.samples_ns);
+    CHECK(near(z_faster, -z, 1e-9));
+    CHECK(faster_significant);
+
+    const auto [z_same, same_significant] = Bench::_detail::mann_whitney(fast.samples_ns, fast.samples_ns);
+    CHECK(near(z_same, 0, 1e-9));
+    CHECK(!same_significant);
+
+    // all values tied: no variance, never significant
+    const std::vector<double> flat(20, 5.0);
+    CHECK(!Bench::_detail::mann_whitney(flat, flat).second);
+}
+
+static void test_welch() {
+    Bench::Result baseline, current;
+    baseline.samples = current.samples = 30;
+    baseline.stddev_ns = current.stddev_ns = 10;
+    baseline.ns_per_op = 100;
+    current.ns_per_op = 110;
+
+    // t = 10 / sqrt(100 / 30 + 100 / 30)
+    const auto [t, significant] = Bench::_detail::welch(baseline, current);
+    CHECK(near(t, 10 / std::sqrt(200.0 / 30), 1e-9));
+    CHECK(significant);
+
+    current.ns_per_op = 102;
+    CHECK(!Bench::_detail::welch(baseline, current).second);
+
+    current.samples = 1;
+    CHECK(!Bench::_detail::welch(baseline, current).second);
+}
+
+static Bench::Report make_report(double first_ns) {
+    Bench::Report report;
+    report.metadata = {"gcc \"12\"", "-O2 NDEBUG", "Some CPU\tx", "abc123", "2026-01-01T00:00:00Z"};
+    report.results.push_back(make_result("copy,\"quoted\"\nname", first_ns, 30));
+    report.results.push_back(make_result("second", 2 * first_ns, 30));
+    report.results.back().samples_ns.clear();
+    report.results.back().iterations = (uint64_t{1} << 60) + 1;  // not representable as a double
+    report.results.back().bytes_per_second = 1.5e9;
+    return report;
+}
+
+static void test_json_round_trip() {
+    const Bench::Report report = make_report(12.25);
+    std::stringstream stream;
+    Bench::write_json(stream, report);
+    const Bench::Report read = Bench::read_json(stream);
+
+    for (const auto& [key, field] : Bench::_detail::metadata_fields) {
+        CHECK(read.metadata.*field == report.metadata.*field);
+    }
+    CHECK(read.results.size() == report.results.size());
+    for (size_t i = 0; i < std::min(read.results.size(), report.results.size()); ++i) {
+        const Bench::Result &a = read.results[i], &b = report.results[i];
+        CHECK(a.name == b.name);
+        CHECK(a.iterations == b.iterations);
+        CHECK(a.samples == b.samples);
+        CHECK(a.outliers == b.outliers);
+        CHECK(a.samples_ns == b.samples_ns);
+        for (const auto& [key, field] : Bench::_detail::result_fields) {
+            CHECK(a.*field == b.*field);
+        }
+    }
+
+    // JSON has no NaN or infinity: written as null, read back as NaN
+    Bench::Report odd = report;
+    odd.results[0].ns_per_op = std::numeric_limits<double>::infinity();
+    odd.results[0].samples_ns[3] = std::numeric_limits<double>::quiet_NaN();
+    std::stringstream odd_stream;
+    Bench::write_json(odd_stream, odd);
+    CHECK(odd_stream.str().find("\"ns_per_op\": null") != std::string::npos);
+    CHECK(odd_stream.str().find("inf") == std::string::npos && odd_stream.str().find("nan") == std::string::npos);
+    const Bench::Report odd_read = Bench::read_json(odd_stream);
+    CHECK(std::isnan(odd_read.results[0].ns_per_op));
+    CHECK(std::isnan(odd_read.results[0].samples_ns[3]));
+    CHECK(odd_read.results[0].samples_ns[4] == odd.results[0].samples_ns[4]);
+
+    std::stringstream broken("{\"results\": [{\"name\": 1}]}");
+    bool threw = false;
+    try {
+        (void)Bench::read_json(broken);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    CHECK(threw);
+}
+
+// plain CSV: a header and one row per result with the same number of columns, metadata in every row
+static void test_csv() {
+    std::stringstream stream;
+    Bench::write_csv(stream, make_report(10));
+    const std::string csv = stream.str();
+
+    CHECK(csv.rfind("name,iterations,samples,outliers,ns_per_op,", 0) == 0);
+    CHECK(csv.find('#') == std::string::npos);
+    CHECK(csv.find(",compiler,flags,cpu,commit,date\n") != std::string::npos);
+    CHECK(csv.find("\"copy,\"\"quoted\"\"\nname\"") != std::string::npos);
+
+    // count the columns of each record, outside quotes
+    std::vector<size_t> columns{1};
+    bool quoted = false;
+    for (size_t i = 0; i + 1 < csv.size(); ++i) {
+        if (csv[i] == '"') {
+            quoted = !quoted;
+        } else if (!quoted && csv[i] == ',') {
+            ++columns.back();
+        } else if (!quoted && csv[i] == '\n') {
+            columns.push_back(1);
+        }
+    }
+    CHECK(columns.size() == 3);
+    CHECK(std::ranges::count(columns, 4 + Bench::_detail::result_fields.size() + Bench::_detail::metadata_fields.size()) == 3);
+    CHECK(std::ranges::count(csv, '\n') == 3 + 1);  // one of them inside the quoted name
+    CHECK(csv.find("\"abc123\",\"2026-01-01T00:00:00Z\"\n") != std::string::npos);
+}
+
+static void test_check_baseline() {
+    const auto path = (std::filesystem::temp_directory_path() / "bench_test_baseline.json").string();
+    CHECK(Bench::save_json(path, make_report(100)));
+
+    std::ostringstream out;
+    CHECK(Bench::check_baseline(path, make_report(100), out) == 0);
+    CHECK(Bench::check_baseline(path, make_report(80), out) == 0);  // faster is not a regression
+    CHECK(Bench::check_baseline(path, make_report(130), out) == 1);
+    CHECK(out.str().find("REGRESSION") != std::string::npos);
+
+    // a change inside the threshold is not reported even if significant
+    CHECK(Bench::check_baseline(path, make_report(100.5), out, 0.05) == 0);
+
+    std::filesystem::remove(path);
+    CHECK(Bench::check_baseline(path, make_report(100), out) == 2);
+}
+
+int main() {
+    test_mann_whitney();
+    test_welch();
+    test_json_round_trip();
+    test_csv();
+    test_check_baseline();
+    return check_result();
+}
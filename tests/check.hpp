@@ -0,0 +1,23 @@
+#pragma once
+
+// minimal assertion helper shared by the test programs: each failed CHECK is reported and counted,
+// main() returns check_result() so a failure shows up as a non-zero exit status
+
+#include <cstdio>
+
+inline int check_failures = 0;
+
+#define CHECK(condition)                                                                          \
+    do {                                                                                          \
+        if (!(condition)) {                                                                       \
+            ++check_failures;                                                                     \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition);    \
+        }                                                                                         \
+    } while (false)
+
+inline int check_result() {
+    if (check_failures) {
+        std::fprintf(stderr, "%d check(s) failed\n", check_failures);
+    }
+    return check_failures ? 1 : 0;
+}
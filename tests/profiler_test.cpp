@@ -0,0 +1,114 @@
+// Tests for include/profiler.hpp
+//
+// build e.g. g++ -std=c++23 -O2 -pthread profiler_test.cpp
+//         or cl /std:c++latest /O2 /EHsc profiler_test.cpp
+
+#define PROFILER_ENABLED 1
+#define PROFILER_MAX_EVENTS 10000  // rounded up to 3 chunks of 4096 events
+
+#include <atomic>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "../include/profiler.hpp"
+#include "check.hpp"
+
+static uint64_t recorded_calls() {
+    return Profiler::build_call_tree().calls;
+}
+
+static void test_call_tree() {
+    Profiler::clear();
+    {
+        PROFILE_SCOPE("outer");
+        for (int i = 0; i < 3; ++i) {
+            PROFILE_SCOPE("inner");
+        }
+    }
+
+    const Profiler::CallNode root = Profiler::build_call_tree();
+    CHECK(root.children.size() == 1);
+    if (root.children.size() == 1) {
+        const Profiler::CallNode& outer = root.children[0];
+        CHECK(outer.name == "outer" && outer.calls == 1);
+        CHECK(outer.children.size() == 1 && outer.children[0].calls == 3);
+        CHECK(outer.exclusive <= outer.inclusive);
+    }
+}
+
+static void test_clear() {
+    Profiler::clear();
+    {
+        PROFILE_SCOPE("before");
+    }
+    CHECK(recorded_calls() == 1);
+
+    Profiler::clear();
+    CHECK(recorded_calls() == 0);
+    std::ostringstream trace;
+    Profiler::write_chrome_trace(trace);
+    CHECK(trace.str().find("before") == std::string::npos);
+
+    // scopes open across clear() are not recorded, but keep working
+    {
+        PROFILE_SCOPE("open");
+        Profiler::clear();
+        PROFILE_SCOPE("nested");
+    }
+    CHECK(recorded_calls() == 0);
+
+    {
+        PROFILE_SCOPE("after");
+    }
+    CHECK(recorded_calls() == 1);
+}
+
+// a thread stops recording at the cap and counts what it dropped
+static void test_cap() {
+    Profiler::clear();
+    for (int i = 0; i < 20000; ++i) {
+        PROFILE_SCOPE("many");
+    }
+    CHECK(recorded_calls() == 3 * 4096);
+    CHECK(Profiler::dropped_events() == 20000 - 3 * 4096);
+
+    Profiler::clear();
+    CHECK(Profiler::dropped_events() == 0);
+}
+
+// clearing while other threads record
+static void test_clear_concurrently() {
+    std::atomic<bool> stop = false;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&] {
+            while (!stop.load()) {
+                PROFILE_SCOPE("worker");
+                PROFILE_SCOPE("step");
+            }
+        });
+    }
+    for (int i = 0; i < 200; ++i) {
+        Profiler::clear();
+        (void)Profiler::build_call_tree();
+        std::this_thread::yield();
+    }
+    stop = true;
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    const Profiler::CallNode root = Profiler::build_call_tree();
+    for (const Profiler::CallNode& child : root.children) {
+        CHECK(child.name == "worker");
+    }
+}
+
+int main() {
+    test_call_tree();
+    test_clear();
+    test_cap();
+    test_clear_concurrently();
+    return check_result();
+}
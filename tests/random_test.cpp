@@ -0,0 +1,671 @@
+// Tests for include/random.hpp
+//
+// build e.g. g++ -std=c++23 -O2 -pthread random_test.cpp -ltbb
+//         or cl /std:c++latest /O2 /EHsc random_test.cpp
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <execution>
+#include <iterator>
+#include <limits>
+#include <list>
+#include <map>
+#include <numeric>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../include/random.hpp"
+#include "check.hpp"
+
+// jump(engine, n) lands on the same state as engine.discard(n), for the fast LCG paths and the fallback
+template <typename Engine>
+static void check_jump_matches_discard(typename Engine::result_type seed) {
+    for (unsigned long long count : {0ull, 1ull, 2ull, 7ull, 1000ull, 123457ull, 1ull << 20}) {
+        Engine jumped(seed), stepped(seed);
+        API_Random::jump(jumped, count);
+        stepped.discard(count);
+        CHECK(jumped == stepped);
+        CHECK(jumped() == stepped());
+    }
+}
+
+static void test_jump() {
+    check_jump_matches_discard<std::minstd_rand>(42);
+    check_jump_matches_discard<std::minstd_rand0>(12345);
+    check_jump_matches_discard<std::linear_congruential_engine<uint64_t, 6364136223846793005u, 1442695040888963407u, 0>>(
+        0x853c49e6748fea9b);
+    check_jump_matches_discard<API_Random::MinstdRand>(7);
+    check_jump_matches_discard<std::mt19937>(5489);  // no fast path, falls back to discard
+}
+
+// the same (key, stream) always gives the same engine, different streams give different ones
+static void test_make_stream() {
+    auto a = API_Random::make_stream<std::mt19937_64>(99, 3);
+    auto b = API_Random::make_stream<std::mt19937_64>(99, 3);
+    auto c = API_Random::make_stream<std::mt19937_64>(99, 4);
+    CHECK(a == b);
+    CHECK(a() != c());
+
+    auto d = API_Random::make_stream<std::minstd_rand>(99, 3);
+    auto e = API_Random::make_stream<std::minstd_rand>(99, 3);
+    CHECK(d() == e());
+}
+
+// the policy overloads of fill_range give the same values for every policy, across several stream blocks
+static void test_parallel_fill() {
+    constexpr size_t size = 3 * API_Random::stream_block_size + 12345;
+
+    std::vector<uint32_t> seq(size), par(size), par_unseq(size);
+    Random_t<>(11).fill_range(std::execution::seq, seq, 3u, 1000000u);
+    Random_t<>(11).fill_range(std::execution::par, par, 3u, 1000000u);
+    Random_t<>(11).fill_range(std::execution::par_unseq, par_unseq, 3u, 1000000u);
+    CHECK(seq == par);
+    CHECK(seq == par_unseq);
+    CHECK(std::ranges::all_of(par, [](uint32_t v) { return v >= 3 && v <= 1000000; }));
+
+    // blocks come from different streams
+    CHECK(!std::equal(par.begin(), par.begin() + 1000, par.begin() + API_Random::stream_block_size));
+
+    std::vector<double> real_seq(size), real_par(size);
+    Random_t<std::mt19937_64>(5).fill_range(std::execution::seq, real_seq, -1.0, 1.0);
+    Random_t<std::mt19937_64>(5).fill_range(std::execution::par, real_par, -1.0, 1.0);
+    CHECK(real_seq == real_par);
+
+    CHECK((Random_t<>(8).get_vector<int64_t>(std::execution::par, size, -50, 50))
+          == (Random_t<>(8).get_vector<int64_t>(std::execution::seq, size, -50, 50)));
+}
+
+// parallel_shuffle yields a permutation that doesn't depend on the policy, and every permutation is equally likely
+static void test_parallel_shuffle() {
+    constexpr size_t size = 200003;
+    std::vector<uint32_t> seq(size), par(size);
+    std::iota(seq.begin(), seq.end(), 0u);
+    std::iota(par.begin(), par.end(), 0u);
+    API_Random::parallel_shuffle<std::mt19937_64>(std::execution::seq, seq.begin(), size, 77, 4096);
+    API_Random::parallel_shuffle<std::mt19937_64>(std::execution::par, par.begin(), size, 77, 4096);
+    CHECK(seq == par);
+
+    std::vector<uint32_t> sorted = par;
+    std::ranges::sort(sorted);
+    bool identity = true;
+    for (size_t i = 0; i < size; ++i) {
+        identity = identity && sorted[i] == i;
+    }
+    CHECK(identity);
+    CHECK(!std::ranges::is_sorted(par));
+
+    std::vector<int> a(100000), b(100000);
+    std::iota(a.begin(), a.end(), 0);
+    std::iota(b.begin(), b.end(), 0);
+    Random_t<>(9).shuffle_range(std::execution::seq, a);
+    Random_t<>(9).shuffle_range(std::execution::par_unseq, b);
+    CHECK(a == b);
+
+    // 5 elements in blocks of 2 go through two merge levels; chi-square over the 120 permutations
+    constexpr int trials = 240000;
+    std::map<std::array<int, 5>, int> counts;
+    for (int trial = 0; trial < trials; ++trial) {
+        std::array<int, 5> permutation{0, 1, 2, 3, 4};
+        API_Random::parallel_shuffle<API_Random::Philox4x32>(std::execution::seq, permutation.begin(), 5, trial, 2);
+        ++counts[permutation];
+    }
+    CHECK(counts.size() == 120);
+    const double expected = trials / 120.0;
+    double chi_square = 0;
+    for (const auto& [permutation, count] : counts) {
+        chi_square += (count - expected) * (count - expected) / expected;
+    }
+    CHECK(chi_square < 190);  // 119 degrees of freedom, p < 1e-4
+}
+
+// unseeded instances get their streams from the master seed alone; seeded instances don't use up instance ids
+static void test_master_seed() {
+    const auto draws = [](Random_t<std::mt19937_64>& random) {
+        std::array<uint64_t, 8> values;
+        for (uint64_t& value : values) {
+            value = random.in_range<uint64_t>();
+        }
+        return values;
+    };
+
+    API_Random::SeedRegistry::set_master_seed(1234);
+    Random_t<std::mt19937_64> first;
+    Random_t<std::mt19937_64> seeded_a(1), seeded_b(2);
+    Random_t<std::mt19937_64> second;
+    const auto first_values = draws(first), second_values = draws(second);
+
+    API_Random::SeedRegistry::set_master_seed(1234);
+    Random_t<std::mt19937_64> first_again;
+    Random_t<std::mt19937_64> second_again;
+    CHECK(draws(first_again) == first_values);
+    CHECK(draws(second_again) == second_values);
+    CHECK(first_values != second_values);
+
+    // the seeded constructor gives the plain engine state
+    Random_t<std::mt19937_64> seeded(7);
+    std::mt19937_64 plain(7);
+    CHECK(seeded.in_range<uint64_t>(0, std::numeric_limits<uint64_t>::max()) == plain());
+}
+
+// chi-square of counts that should all be equal
+static double chi_square(const std::vector<int>& counts) {
+    double total = 0;
+    for (const int count : counts) {
+        total += count;
+    }
+    const double expected = total / static_cast<double>(counts.size());
+    double sum = 0;
+    for (const int count : counts) {
+        sum += (count - expected) * (count - expected) / expected;
+    }
+    return sum;
+}
+
+// bounded and bounded_in_range stay in range and are unbiased, including the full-width and narrow-type edge cases
+static void test_bounded() {
+    std::mt19937_64 engine(21);
+    std::minstd_rand small_engine(21);
+
+    for (const uint32_t bound : {1u, 2u, 3u, 6u, 1000u, 0x80000001u, 0xffffffffu}) {
+        bool in_range = true;
+        for (int i = 0; i < 2000; ++i) {
+            in_range = in_range && API_Random::bounded<uint32_t>(engine, bound) < bound;
+            in_range = in_range && API_Random::bounded<uint64_t>(small_engine, uint64_t{bound} << 20) < uint64_t{bound} << 20;
+        }
+        CHECK(in_range);
+    }
+
+    // a bound of 3 * 2^30 (3 * 2^62): modulo reduction would put half the draws below a third of it
+    constexpr int draws = 300000;
+    int low32 = 0, low64 = 0;
+    for (int i = 0; i < draws; ++i) {
+        low32 += API_Random::bounded<uint32_t>(engine, 3u << 30) < (1u << 30);
+        low64 += API_Random::bounded<uint64_t>(engine, uint64_t{3} << 62) < (uint64_t{1} << 62);
+    }
+    CHECK(std::abs(low32 / static_cast<double>(draws) - 1.0 / 3) < 0.01);
+    CHECK(std::abs(low64 / static_cast<double>(draws) - 1.0 / 3) < 0.01);
+
+    std::vector<int> dice(6);
+    for (int i = 0; i < 600000; ++i) {
+        ++dice[API_Random::bounded_in_range(engine, 1, 6) - 1];
+    }
+    CHECK(chi_square(dice) < 25);  // 5 degrees of freedom, p < 1e-4
+
+    // every int8_t value over the full range, and reversed bounds are swapped
+    std::vector<int> bytes(256);
+    for (int i = 0; i < 256 * 2000; ++i) {
+        ++bytes[API_Random::bounded_in_range<int8_t>(engine, -128, 127) + 128];
+    }
+    CHECK(chi_square(bytes) < 340);  // 255 degrees of freedom, p < 1e-3
+    bool swapped_ok = true;
+    for (int i = 0; i < 1000; ++i) {
+        const auto value = API_Random::bounded_in_range<int8_t>(engine, 5, -5);
+        swapped_ok = swapped_ok && value >= -5 && value <= 5;
+    }
+    CHECK(swapped_ok);
+
+    // full 64-bit ranges: each half and the top bit come up about half the time
+    int negative = 0, top_bit = 0, small_top_bit = 0;
+    for (int i = 0; i < draws; ++i) {
+        negative += API_Random::bounded_in_range(engine, std::numeric_limits<int64_t>::lowest(), std::numeric_limits<int64_t>::max()) < 0;
+        top_bit += API_Random::bounded_in_range<uint64_t>(engine, 0, std::numeric_limits<uint64_t>::max()) >> 63;
+        // a 31-bit engine still fills all 64 bits
+        small_top_bit += API_Random::bounded_in_range<uint64_t>(small_engine, 0, std::numeric_limits<uint64_t>::max()) >> 63;
+    }
+    CHECK(std::abs(negative / static_cast<double>(draws) - 0.5) < 0.01);
+    CHECK(std::abs(top_bit / static_cast<double>(draws) - 0.5) < 0.01);
+    CHECK(std::abs(small_top_bit / static_cast<double>(draws) - 0.5) < 0.01);
+
+    // a 32-bit engine is concatenated into a 64-bit word, high part first
+    std::mt19937 words(3), reference(3);
+    const uint64_t high = reference(), low = reference();
+    CHECK(API_Random::uniform_bits<uint64_t>(words) == (high << 32 | low));
+
+    int trues = 0;
+    for (int i = 0; i < draws; ++i) {
+        trues += API_Random::bounded_in_range(engine, false, true);
+    }
+    CHECK(std::abs(trues / static_cast<double>(draws) - 0.5) < 0.01);
+    CHECK(API_Random::bounded_in_range(engine, true, true));
+    CHECK(!API_Random::bounded_in_range(engine, false, false));
+    CHECK(API_Random::bounded_in_range<int16_t>(engine, -7, -7) == -7);
+}
+
+// fill_chars only uses the given symbols, each about equally often, for power-of-two and other table sizes
+static void test_fill_chars() {
+    std::mt19937_64 engine(4);
+    for (const std::string_view symbols : {std::string_view("x"), std::string_view("01"), API_Random::Charsets::hex.view(),
+                                           API_Random::Charsets::alpha.view(), API_Random::Charsets::alnum.view(),
+                                           std::string_view("abc")}) {
+        std::string out(symbols.size() * 4000 + 7, '\0');  // not a whole number of words
+        API_Random::fill_chars(engine, out, symbols);
+
+        std::vector<int> counts(symbols.size());
+        bool known = true;
+        for (const char c : out) {
+            const size_t idx = symbols.find(c);
+            known = known && idx != std::string_view::npos;
+            if (idx != std::string_view::npos) {
+                ++counts[idx];
+            }
+        }
+        CHECK(known);
+        CHECK(chi_square(counts) < 2.0 * static_cast<double>(symbols.size() - 1) + 20);  // far in the tail for every size
+    }
+
+    std::string untouched = "keep";
+    API_Random::fill_chars(engine, untouched, "");
+    CHECK(untouched == "keep");
+
+    const std::string digits = Random_t<>(6).get_string(100, API_Random::Charsets::digits);
+    CHECK(digits.size() == 100 && std::ranges::all_of(digits, [](char c) { return c >= '0' && c <= '9'; }));
+}
+
+// a batch lays its strings back to back, each within the length bounds and made of the given symbols
+static void test_string_batch() {
+    std::mt19937_64 engine(5);
+    const API_Random::RandomStringBatch batch = API_Random::RandomStringBatch::generate(engine, 1000, 3, 9, "abcdef");
+
+    CHECK(batch.size() == 1000 && !batch.empty());
+    CHECK(batch.offsets().size() == 1001 && batch.offsets().front() == 0);
+    CHECK(batch.offsets().back() == batch.arena().size());
+    CHECK(batch.arena().find_first_not_of("abcdef") == std::string_view::npos);
+
+    std::map<size_t, int> lengths;
+    bool contiguous = true;
+    for (size_t i = 0; i < batch.size(); ++i) {
+        ++lengths[batch[i].size()];
+        contiguous = contiguous && batch[i].data() == batch.arena().data() + batch.offsets()[i];
+    }
+    CHECK(contiguous);
+    CHECK(lengths.size() == 7 && lengths.begin()->first == 3 && lengths.rbegin()->first == 9);
+
+    const std::vector<std::string> copies = batch.to_vector();
+    CHECK(std::ranges::equal(copies, batch.views()));
+
+    // the same seed gives the same batch through Random_t
+    const auto first = Random_t<>(8).get_string_batch(50, "xyz", 0u, 4u), second = Random_t<>(8).get_string_batch(50, "xyz", 0u, 4u);
+    CHECK(first.arena() == second.arena() && std::ranges::equal(first.offsets(), second.offsets()));
+
+    const API_Random::RandomStringBatch empty = API_Random::RandomStringBatch::generate(engine, 10, 0, 0, "abc");
+    CHECK(empty.size() == 10 && empty.arena().empty() && empty[9].empty());
+    CHECK(API_Random::RandomStringBatch().empty());
+}
+
+// sample returns distinct elements, no more than asked for, each element included equally often
+template <typename Range>
+static void check_sample(Range&& range, size_t count) {
+    Random_t<std::mt19937_64> random(10);
+    std::vector<int> included(32);
+    bool valid = true;
+
+    for (int round = 0; round < 20000; ++round) {
+        std::vector<int> picked;
+        random.sample(range, count, std::back_inserter(picked));
+        valid = valid && picked.size() == std::min<size_t>(count, 32);
+        for (const int value : picked) {
+            ++included[value];
+        }
+        std::ranges::sort(picked);
+        valid = valid && std::ranges::adjacent_find(picked) == picked.end();
+    }
+    CHECK(valid);
+    CHECK(chi_square(included) < 80);  // 31 degrees of freedom, p < 1e-5
+}
+
+static void test_sample() {
+    std::vector<int> values(32);
+    std::iota(values.begin(), values.end(), 0);
+    const std::list<int> list(values.begin(), values.end());
+
+    check_sample(values, 2);   // sparse Fisher-Yates
+    check_sample(values, 12);  // dense Fisher-Yates
+    check_sample(list, 2);     // Algorithm L
+    check_sample(list, 12);
+    check_sample(values, 40);  // more than there are: all of them
+    check_sample(list, 40);
+
+    std::vector<int> none;
+    Random_t<>(1).sample(values, 0, std::back_inserter(none));
+    CHECK(none.empty());
+}
+
+// BufferedRandom hands out the wrapped engine's 64-bit words in order, across refills and reseeds
+static void test_buffered_random() {
+    API_Random::BufferedRandom<std::mt19937, 4> buffered(12);
+    std::mt19937 reference(12);
+
+    bool same = true;
+    for (int i = 0; i < 10; ++i) {  // two and a half blocks
+        same = same && buffered() == API_Random::uniform_bits<uint64_t>(reference);
+    }
+    CHECK(same);
+
+    buffered.seed(13);
+    reference.seed(13);
+    CHECK(buffered() == API_Random::uniform_bits<uint64_t>(reference));
+
+    // bits and bytes come from their own cached words
+    API_Random::BufferedRandom<std::mt19937_64> bits(14);
+    std::mt19937_64 words(14);
+    const uint64_t first = words();
+    bool bits_match = true;
+    for (int i = 0; i < 64; ++i) {
+        bits_match = bits_match && bits.next_bool() == static_cast<bool>(first >> i & 1);
+    }
+    CHECK(bits_match);
+    const uint64_t second = words();
+    bool bytes_match = true;
+    for (int i = 0; i < 8; ++i) {
+        bytes_match = bytes_match && bits.next_byte() == static_cast<uint8_t>(second >> 8 * i);
+    }
+    CHECK(bytes_match);
+
+    bool in_range = true;
+    for (int i = 0; i < 1000; ++i) {
+        const int value = bits.in_range(-3, 3);
+        in_range = in_range && value >= -3 && value <= 3;
+    }
+    CHECK(in_range);
+
+    // usable as the engine of Random_t
+    Random_t<API_Random::BufferedRandom<std::mt19937_64>> random(15);
+    const auto value = random.in_range(10, 20);
+    CHECK(value >= 10 && value <= 20);
+}
+
+// the little-endian bytes of consecutive 64-bit words, the last one truncated
+template <typename Engine>
+static std::vector<std::byte> reference_bytes(Engine& engine, size_t size) {
+    std::vector<std::byte> bytes;
+    while (bytes.size() < size) {
+        const uint64_t word = API_Random::uniform_bits<uint64_t>(engine);
+        for (int i = 0; i < 8 && bytes.size() < size; ++i) {
+            bytes.push_back(static_cast<std::byte>(word >> 8 * i));
+        }
+    }
+    return bytes;
+}
+
+// fill_bytes gives the same bytes on the Philox block path as word by word, from any position and for any tail
+static void test_fill_bytes() {
+    for (const size_t size : {0, 5, 8, 13, 16, 37, 517, 1029}) {
+        for (int skip = 0; skip < 4; ++skip) {
+            API_Random::Philox4x32 engine(16, 3), reference(16, 3);
+            engine.discard(skip);
+            reference.discard(skip);
+
+            std::vector<std::byte> bytes(size);
+            API_Random::fill_bytes(engine, std::span(bytes));
+            CHECK(bytes == reference_bytes(reference, size));
+            CHECK(engine() == reference());
+        }
+
+        std::mt19937 engine(17), reference(17);
+        std::vector<std::byte> bytes(size);
+        API_Random::fill_bytes(engine, std::span(bytes));
+        CHECK(bytes == reference_bytes(reference, size));
+    }
+}
+
+static std::string encode_base64(std::string_view text, const API_Random::Charset& alphabet = API_Random::Charsets::base64,
+                                 bool pad = true) {
+    return API_Random::to_base64(std::as_bytes(std::span(text)), alphabet, pad);
+}
+
+// known answers, base64 from RFC 4648 section 10
+static void test_encodings() {
+    const std::array bytes{std::byte{0x00}, std::byte{0x01}, std::byte{0xab}, std::byte{0xff}};
+    CHECK(API_Random::to_hex(bytes) == "0001abff");
+    CHECK(API_Random::to_hex(bytes, API_Random::Charsets::hex_upper) == "0001ABFF");
+    CHECK(API_Random::to_hex({}).empty());
+
+    CHECK(encode_base64("").empty());
+    CHECK(encode_base64("f") == "Zg==");
+    CHECK(encode_base64("fo") == "Zm8=");
+    CHECK(encode_base64("foo") == "Zm9v");
+    CHECK(encode_base64("foob") == "Zm9vYg==");
+    CHECK(encode_base64("fooba") == "Zm9vYmE=");
+    CHECK(encode_base64("foobar") == "Zm9vYmFy");
+    CHECK(encode_base64("\xfb\xff") == "+/8=");
+    CHECK(encode_base64("\xfb\xff", API_Random::Charsets::base64url, false) == "-_8");
+
+    bool threw = false;
+    try {
+        (void)API_Random::to_hex(bytes, API_Random::Charsets::digits);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    CHECK(threw);
+
+    const std::string token = Random_t<>(18).get_hex_token(20);
+    CHECK(token.size() == 40 && token.find_first_not_of("0123456789abcdef") == std::string::npos);
+}
+
+// the sample mean and variance of a distribution are close to the given ones, for scalar draws and for fill
+template <typename Distribution>
+static void check_moments(const Distribution& distribution, double mean, double variance) {
+    using Value = typename Distribution::result_type;
+    constexpr size_t draws = 400000;
+    std::mt19937_64 engine(21);
+
+    std::vector<Value> values(draws);
+    distribution.fill(engine, std::span(values));
+    for (size_t i = 0; i < draws; ++i) {
+        values.push_back(distribution(engine));
+    }
+
+    for (const std::span<const Value> half : {std::span<const Value>(values).first(draws), std::span<const Value>(values).last(draws)}) {
+        double sum = 0, sum_squares = 0;
+        for (const Value value : half) {
+            sum += static_cast<double>(value);
+        }
+        const double sample_mean = sum / draws;
+        for (const Value value : half) {
+            sum_squares += (static_cast<double>(value) - sample_mean) * (static_cast<double>(value) - sample_mean);
+        }
+        CHECK(std::abs(sample_mean - mean) < 0.01 * std::max(std::abs(mean), std::sqrt(variance)));
+        CHECK(std::abs(sum_squares / (draws - 1) - variance) < 0.03 * variance);
+    }
+}
+
+static void test_distribution_moments() {
+    check_moments(API_Random::Normal<>{2, 3}, 2, 9);
+    check_moments(API_Random::Normal<float>{-1, 0.5f}, -1, 0.25);
+    check_moments(API_Random::Exponential<>{0.5}, 2, 4);
+    check_moments(API_Random::LogNormal<>{0, 0.5}, std::exp(0.125), (std::exp(0.25) - 1) * std::exp(0.25));
+    check_moments(API_Random::Gamma<>{2.5, 2}, 5, 10);
+    check_moments(API_Random::Gamma<>{0.5, 1}, 0.5, 0.5);  // shape below 1 takes the boosted path
+    check_moments(API_Random::Poisson<>{3.5}, 3.5, 3.5);   // inversion
+    check_moments(API_Random::Poisson<int32_t>{40}, 40, 40);  // transformed rejection
+}
+
+static bool sampler_rejects(std::vector<double> weights) {
+    try {
+        API_Random::WeightedSampler sampler(weights);
+    } catch (const std::invalid_argument&) {
+        return true;
+    }
+    return false;
+}
+
+// indices come up in proportion to their weights, zero weights never, and bad weights are refused
+static void test_weighted_sampler() {
+    CHECK(sampler_rejects({}));
+    CHECK(sampler_rejects({0, 0}));
+    CHECK(sampler_rejects({1, -1}));
+    CHECK(sampler_rejects({1, std::numeric_limits<double>::quiet_NaN()}));
+    CHECK(sampler_rejects({1, std::numeric_limits<double>::infinity()}));
+
+    const std::vector<double> weights{1, 0, 2, 3, 0, 4};
+    API_Random::WeightedSampler sampler(weights);
+    CHECK(sampler.size() == weights.size());
+
+    constexpr int draws = 1000000;
+    std::mt19937_64 engine(19);
+    std::vector<size_t> indices(draws);
+    sampler.fill(engine, indices);
+    for (int i = 0; i < draws; ++i) {
+        indices.push_back(sampler(engine));
+    }
+
+    std::vector<int> counts(weights.size());
+    for (const size_t idx : indices) {
+        ++counts[idx];
+    }
+    CHECK(counts[1] == 0 && counts[4] == 0);
+    // half the draws come from fill, half one at a time: 2 * draws over a total weight of 10
+    CHECK(std::abs(counts[0] - 2 * draws / 10) < 2500);
+    CHECK(std::abs(counts[2] - 4 * draws / 10) < 3000);
+    CHECK(std::abs(counts[3] - 6 * draws / 10) < 3500);
+    CHECK(std::abs(counts[5] - 8 * draws / 10) < 3500);
+
+    // staged changes apply on rebuild: only the new index is left
+    for (size_t idx = 0; idx < weights.size(); ++idx) {
+        sampler.set_weight(idx, 0);
+    }
+    sampler.push_back(5);
+    sampler.rebuild();
+    CHECK(sampler.size() == weights.size() + 1);
+    bool only_last = true;
+    for (int i = 0; i < 1000; ++i) {
+        only_last = only_last && sampler(engine) == weights.size();
+    }
+    CHECK(only_last);
+
+    const std::array<char, 7> letters{'a', 'b', 'c', 'd', 'e', 'f', 'g'};
+    CHECK(Random_t<>(20).get_elem(letters, sampler) == 'g');
+}
+
+// MinstdRand reproduces std::minstd_rand, including seed_seq seeding
+static void test_constexpr_engine() {
+    API_Random::MinstdRand mine(42);
+    std::minstd_rand std_engine(42);
+    for (int i = 0; i < 1000; ++i) {
+        CHECK(mine() == std_engine());
+    }
+
+    std::seed_seq seq_a{1, 2, 3}, seq_b{1, 2, 3};
+    API_Random::MinstdRand0 seeded(seq_a);
+    std::minstd_rand0 std_seeded(seq_b);
+    for (int i = 0; i < 1000; ++i) {
+        CHECK(seeded() == std_seeded());
+    }
+}
+
+// the compile-time helpers produce what Random_t produces from the same seed
+static void test_tables() {
+    constexpr auto table = API_Random::make_table<uint32_t, 64>(API_Random::MinstdRand(42));
+    CHECK(table == (Random_t<>(42).get_array<uint32_t, 64>()));
+
+    constexpr auto small = API_Random::make_table<int16_t, 100>(API_Random::MinstdRand(7), -5, 5);
+    CHECK(small == (Random_t<>(7).get_array<int16_t, 100>(-5, 5)));
+
+    constexpr auto permutation = API_Random::make_permutation<uint16_t, 257>(API_Random::MinstdRand(3));
+    std::array<uint16_t, 257> shuffled;
+    for (size_t i = 0; i < shuffled.size(); ++i) {
+        shuffled[i] = static_cast<uint16_t>(i);
+    }
+    Random_t<>(3).shuffle_range(shuffled);
+    CHECK(permutation == shuffled);
+}
+
+template <typename Distribution>
+static bool rejects(const Distribution& distribution) {
+    std::mt19937_64 engine(1);
+    try {
+        (void)distribution(engine);
+    } catch (const std::invalid_argument&) {
+        return true;
+    }
+    return false;
+}
+
+// every distribution throws std::invalid_argument on parameters it can't sample
+static void test_distribution_parameters() {
+    constexpr double nan = std::numeric_limits<double>::quiet_NaN(), inf = std::numeric_limits<double>::infinity();
+
+    CHECK(rejects(API_Random::Normal<>{0, -1}));
+    CHECK(rejects(API_Random::Normal<>{0, nan}));
+    CHECK(rejects(API_Random::Normal<>{0, inf}));
+    CHECK(!rejects(API_Random::Normal<>{0, 0}));
+
+    CHECK(rejects(API_Random::Exponential<>{0}));
+    CHECK(rejects(API_Random::Exponential<>{-1}));
+    CHECK(rejects(API_Random::Exponential<>{nan}));
+    CHECK(rejects(API_Random::Exponential<>{inf}));
+
+    CHECK(rejects(API_Random::LogNormal<>{0, -1}));
+    CHECK(rejects(API_Random::LogNormal<>{0, nan}));
+
+    CHECK(rejects(API_Random::Gamma<>{0, 1}));
+    CHECK(rejects(API_Random::Gamma<>{1, -1}));
+    CHECK(rejects(API_Random::Gamma<>{nan, 1}));
+    CHECK(rejects(API_Random::Gamma<>{1, nan}));
+    CHECK(!rejects(API_Random::Gamma<>{0.1, 1}));
+
+    CHECK(rejects(API_Random::Poisson<>{-5}));
+    CHECK(rejects(API_Random::Poisson<>{nan}));
+    CHECK(rejects(API_Random::Poisson<>{inf}));
+    CHECK(rejects(API_Random::Poisson<>{1e300}));
+    CHECK(rejects(API_Random::Poisson<int8_t>{64}));
+    CHECK(!rejects(API_Random::Poisson<int8_t>{63}));
+    CHECK(!rejects(API_Random::Poisson<>{0}));
+
+    // large means stay in range
+    std::mt19937_64 engine(2);
+    const API_Random::Poisson<int8_t> narrow{63};
+    for (int i = 0; i < 100000; ++i) {
+        CHECK(narrow(engine) >= 0);
+    }
+    const API_Random::Poisson<> wide{1e18};
+    for (int i = 0; i < 1000; ++i) {
+        const auto k = wide(engine);
+        CHECK(k > 0 && std::abs(static_cast<double>(k) - 1e18) < 1e10);
+    }
+
+    std::vector<double> out(10);
+    bool threw = false;
+    try {
+        API_Random::Exponential<>{-1}.fill(engine, std::span<double>(out));
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    CHECK(threw);
+
+    threw = false;
+    try {
+        API_Random::Gamma<>{-2, 1}.fill(engine, std::span<double>(out));
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    CHECK(threw);
+}
+
+int main() {
+    test_jump();
+    test_make_stream();
+    test_parallel_fill();
+    test_parallel_shuffle();
+    test_master_seed();
+    test_bounded();
+    test_fill_chars();
+    test_string_batch();
+    test_sample();
+    test_buffered_random();
+    test_fill_bytes();
+    test_encodings();
+    test_weighted_sampler();
+    test_constexpr_engine();
+    test_tables();
+    test_distribution_parameters();
+    test_distribution_moments();
+    return check_result();
+}
@@ -0,0 +1,233 @@
+// Tests for include/timer.hpp
+//
+// build e.g. g++ -std=c++23 -O2 -pthread timer_test.cpp
+//         or cl /std:c++latest /O2 /EHsc timer_test.cpp
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "../include/timer.hpp"
+#include "check.hpp"
+
+// the value of the given percentile in sorted data, with the same rank rule as the histogram
+static uint64_t exact_percentile(const std::vector<uint64_t>& sorted, double percent) {
+    const auto rank = static_cast<size_t>(std::ceil(percent / 100.0 * static_cast<double>(sorted.size())));
+    return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+}
+
+// percentiles are never below the true value and at most 1/128 above it
+static void test_percentiles() {
+    std::mt19937_64 rng(1);
+    std::vector<uint64_t> values;
+    HdrHistogram histogram;
+
+    for (int i = 0; i < 200000; ++i) {
+        const uint64_t value = rng() >> (rng() % 60);  // spread over many orders of magnitude
+        values.push_back(value);
+        histogram.record(value);
+    }
+    std::ranges::sort(values);
+
+    CHECK(histogram.count() == values.size());
+    CHECK(histogram.min() == values.front());
+    CHECK(histogram.max() == values.back());
+    for (double percent : {0.1, 1.0, 10.0, 25.0, 50.0, 75.0, 90.0, 99.0, 99.9, 99.99, 100.0}) {
+        const uint64_t exact = exact_percentile(values, percent);
+        const uint64_t estimate = histogram.percentile(percent);
+        CHECK(estimate >= exact);
+        CHECK(static_cast<double>(estimate - exact) <= static_cast<double>(exact) / 128.0);
+    }
+}
+
+// every value below 256 has its own bucket
+static void test_exact_small_values() {
+    HdrHistogram histogram;
+    for (uint64_t value = 0; value < 256; ++value) {
+        histogram.record(value);
+    }
+    for (uint64_t rank = 1; rank <= 256; ++rank) {
+        CHECK(histogram.percentile(100.0 * static_cast<double>(rank) / 256.0) == rank - 1);
+    }
+    CHECK(histogram.mean() == 127.5);
+
+    HdrHistogram single;
+    single.record(std::chrono::nanoseconds(42));
+    CHECK(single.percentile(50) == 42);
+    CHECK(single.percentile(99.9) == 42);
+    CHECK(single.min() == 42 && single.max() == 42);
+}
+
+// merging two histograms gives what recording everything into one gives
+static void test_merge() {
+    std::mt19937_64 rng(2);
+    HdrHistogram combined, left;
+    BasicHdrHistogram<true> right;
+
+    for (int i = 0; i < 50000; ++i) {
+        const uint64_t value = 100 + rng() % 1000000;
+        combined.record(value);
+        if (i % 3) {
+            left.record(value);
+        } else {
+            right.record(value);
+        }
+    }
+    left.merge(right);
+
+    CHECK(left.count() == combined.count());
+    CHECK(left.min() == combined.min());
+    CHECK(left.max() == combined.max());
+    CHECK(std::abs(left.mean() - combined.mean()) <= 1e-9 * combined.mean());
+    CHECK(std::abs(left.stddev() - combined.stddev()) <= 1e-9 * combined.stddev());
+    for (double percent : {1.0, 50.0, 90.0, 99.0, 99.9}) {
+        CHECK(left.percentile(percent) == combined.percentile(percent));
+    }
+
+    HdrHistogram empty;
+    left.merge(empty);
+    CHECK(left.count() == combined.count());
+}
+
+static void test_reset() {
+    HdrHistogram histogram;
+    for (uint64_t value = 1000; value < 2000; ++value) {
+        histogram.record(value);
+    }
+    histogram.reset();
+
+    CHECK(histogram.count() == 0);
+    CHECK(histogram.min() == 0 && histogram.max() == 0);
+    CHECK(histogram.mean() == 0 && histogram.stddev() == 0);
+    CHECK(histogram.percentile(50) == 0);
+
+    histogram.record(7);
+    CHECK(histogram.count() == 1);
+    CHECK(histogram.percentile(50) == 7);
+}
+
+// threads that use many timers, more than their shard cache holds, and short-lived ones record into the right shard
+static void test_concurrent_timers() {
+    using Timer = ConcurrentBenchTimer<Measurements::ns>;
+    constexpr int timers = 12, rounds = 1000;
+
+    std::vector<std::unique_ptr<Timer>> owned;
+    std::vector<Timer::Id> ids;
+    for (int i = 0; i < timers; ++i) {
+        owned.push_back(std::make_unique<Timer>());
+        ids.push_back(owned.back()->id("step"));
+    }
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&] {
+            for (int round = 0; round < rounds; ++round) {
+                for (int i = 0; i < timers; ++i) {
+                    owned[i]->record(ids[i], std::chrono::nanoseconds(i + 1));
+                }
+                Timer short_lived;
+                short_lived.record(short_lived.id("once"), std::chrono::nanoseconds(5));
+                CHECK(short_lived.histogram(0).count() == 1);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (int i = 0; i < timers; ++i) {
+        const HdrHistogram histogram = owned[i]->histogram(ids[i]);
+        CHECK(histogram.count() == 4 * rounds);
+        CHECK(histogram.min() == static_cast<uint64_t>(i + 1) && histogram.max() == static_cast<uint64_t>(i + 1));
+        CHECK(owned[i]->shard_count() == 4);
+    }
+}
+
+// a clock the test moves by hand
+struct ManualClock {
+    using rep = int64_t;
+    using period = std::nano;
+    using duration = std::chrono::nanoseconds;
+    using time_point = std::chrono::time_point<ManualClock>;
+    static constexpr bool is_steady = true;
+
+    static inline time_point current{};
+
+    static time_point now() noexcept {
+        return current;
+    }
+};
+
+static void test_rate_meter() {
+    using namespace std::chrono_literals;
+    RateMeter<ManualClock, 1> meter;
+
+    // 1000 events per second, read every 50 ms
+    for (int step = 0; step < 300; ++step) {
+        meter.mark(50);
+        ManualClock::current += 50ms;
+        (void)meter.ewma();
+    }
+    RateMeterStats stats = meter.stats();
+    CHECK(stats.count == 15000);
+    CHECK(std::abs(stats.mean - 1000) < 1e-6);
+    CHECK(std::abs(stats.last_1s - 1000) < 1e-6);
+    CHECK(std::abs(stats.last_10s - 1000) < 1e-6);
+    CHECK(std::abs(stats.last_60s - 1000) < 1e-6);  // younger than 60 s: the rate since construction
+
+    // a read 5 s after the last one: the windows inside the gap get its average rate
+    meter.mark(100);
+    ManualClock::current += 5s;
+    stats = meter.stats();
+    CHECK(std::abs(stats.last_1s - 20) < 1e-6);
+    CHECK(std::abs(stats.last_10s - 5100.0 / 10.0) < 1e-6);  // 5000 events in the first 5 s, 100 in the last 5
+    CHECK(std::abs(meter.rate(2s) - 20) < 1e-6);
+
+    // regular reads give the current rate again
+    for (int step = 0; step < 40; ++step) {
+        meter.mark(100);
+        ManualClock::current += 50ms;
+        meter.update();
+    }
+    CHECK(std::abs(meter.rate(1s) - 2000) < 1e-6);
+}
+
+// a poller at exactly the window period, with jitter either way, sees the rate in every window
+static void test_rate_meter_window_period() {
+    using namespace std::chrono_literals;
+    RateMeter<ManualClock, 1> meter;
+
+    std::mt19937 rng(3);
+    for (int poll = 0; poll < 120; ++poll) {
+        const auto period = 1s + std::chrono::microseconds(static_cast<int>(rng() % 2001) - 1000);
+        meter.mark(static_cast<uint64_t>(std::chrono::duration<double>(period).count() * 1e6));  // 1 M events per second
+        ManualClock::current += period;
+
+        const RateMeterStats stats = meter.stats();
+        CHECK(std::abs(stats.last_1s - 1e6) < 1.0);
+        CHECK(std::abs(stats.last_10s - 1e6) < 1.0);
+        CHECK(std::abs(stats.last_60s - 1e6) < 1.0);
+    }
+
+    // one poll every 3 s: each 1 s window reports the average over the 3 s since the previous poll
+    for (int poll = 0; poll < 10; ++poll) {
+        meter.mark(300);
+        ManualClock::current += 3s;
+        CHECK(std::abs(meter.rate(1s) - 100) < 1e-6);
+    }
+}
+
+int main() {
+    test_percentiles();
+    test_exact_small_values();
+    test_merge();
+    test_reset();
+    test_concurrent_timers();
+    test_rate_meter();
+    test_rate_meter_window_period();
+    return check_result();
+}
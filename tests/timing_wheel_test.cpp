@@ -0,0 +1,186 @@
+// Tests for include/timing_wheel.hpp
+//
+// build e.g. g++ -std=c++23 -O2 -pthread timing_wheel_test.cpp
+//         or cl /std:c++latest /O2 /EHsc timing_wheel_test.cpp
+
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "../include/timing_wheel.hpp"
+#include "check.hpp"
+
+using namespace std::chrono_literals;
+
+// every one-shot fires exactly once, on its tick, unless cancelled first
+static void test_one_shot_ticks() {
+    TimingWheel<Measurements::ms> wheel;
+    std::mt19937_64 rng(1);
+
+    constexpr size_t count = 20000;
+    std::vector<uint64_t> due(count);
+    std::vector<int> fired(count);
+    std::vector<TimingWheel<Measurements::ms>::Handle> handles;
+
+    for (size_t i = 0; i < count; ++i) {
+        uint64_t delay = 1 + rng() % (i % 3 ? 500 : 300000);
+        if (i % 1000 == 0) {
+            delay = (uint64_t{1} << 33) + rng() % 1000;  // past the top level
+        }
+        due[i] = wheel.now_ticks() + delay;
+        handles.push_back(wheel.schedule(std::chrono::milliseconds(delay), [&, i] {
+            ++fired[i];
+            CHECK(wheel.now_ticks() == due[i]);
+        }));
+        if (i % 7 == 0) {
+            wheel.tick(rng() % 3);
+        }
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        if (i % 10 && due[i] > wheel.now_ticks()) {
+            CHECK(wheel.cancel(handles[i]));
+            due[i] = 0;
+        }
+    }
+
+    while (const auto next = wheel.next_expiry()) {
+        wheel.tick(static_cast<uint64_t>(next->count()));
+    }
+    for (size_t i = 0; i < count; ++i) {
+        CHECK(fired[i] == (due[i] ? 1 : 0));
+    }
+}
+
+static void test_periodic_and_cancel_from_callback() {
+    TimingWheel<Measurements::ms> wheel;
+    int periodic = 0, cancelled = 0;
+
+    TimingWheel<Measurements::ms>::Handle self, other;
+    self = wheel.schedule_every(10ms, [&] {
+        if (++periodic == 5) {
+            CHECK(wheel.cancel(self));
+        }
+    });
+    other = wheel.schedule(30ms, [&] { ++cancelled; });
+    wheel.schedule(30ms, [&] { CHECK(wheel.cancel(other)); });  // same slot, runs first
+
+    wheel.tick(1000);
+    CHECK(periodic == 5);
+    CHECK(cancelled == 0);
+    CHECK(wheel.empty());
+}
+
+// callbacks that outlast a tick and schedule again must not disturb the batch being expired
+static void test_runner_reschedule_from_slow_callbacks() {
+    constexpr int batch = 64;
+    std::atomic<int> first = 0, second = 0, chained = 0;
+    std::atomic<bool> foreign_thread = false;
+    TimingWheelRunner<Measurements::ms> runner;
+    const auto runner_thread = [&] {
+        std::thread::id id;
+        std::atomic<bool> done = false;
+        runner.schedule(1ms, [&] { id = std::this_thread::get_id(); done = true; });
+        while (!done) {
+            std::this_thread::sleep_for(1ms);
+        }
+        return id;
+    }();
+
+    for (int i = 0; i < batch; ++i) {
+        runner.schedule(20ms, [&] {
+            foreign_thread = foreign_thread || std::this_thread::get_id() != runner_thread;
+            std::this_thread::sleep_for(5ms);
+            ++first;
+            runner.schedule(1ms, [&] { ++chained; });
+        });
+        runner.schedule(22ms, [&] { ++second; });
+    }
+
+    for (int waited = 0; waited < 5000 && chained < batch; waited += 10) {
+        std::this_thread::sleep_for(10ms);
+    }
+    CHECK(first == batch);
+    CHECK(second == batch);
+    CHECK(chained == batch);
+    CHECK(runner.size() == 0);
+    CHECK(!foreign_thread);
+}
+
+// a clock the test moves by hand
+struct ManualClock {
+    using rep = int64_t;
+    using period = std::nano;
+    using duration = std::chrono::nanoseconds;
+    using time_point = std::chrono::time_point<ManualClock>;
+    static constexpr bool is_steady = true;
+
+    static inline time_point current{};
+
+    static time_point now() noexcept {
+        return current;
+    }
+};
+
+// on a polled wheel the delay counts from the clock, not from the tick the last poll() rounded down to
+static void test_poll_never_early() {
+    using namespace std::chrono_literals;
+    ManualClock::current = {};
+    TimingWheel<Measurements::ms, ManualClock> wheel;
+    int fired = 0;
+
+    ManualClock::current += 900us;
+    wheel.poll();
+    wheel.schedule(1ms, [&] { ++fired; });
+
+    ManualClock::current += 1ms;  // 1.9 ms: the wheel's tick 1, one tick after the poll but not 1 ms after scheduling
+    wheel.poll();
+    CHECK(fired == 0);
+
+    ManualClock::current += 100us;  // 2.0 ms
+    wheel.poll();
+    CHECK(fired == 1);
+
+    // tick() keeps counting from the wheel's own time
+    wheel.schedule(1ms, [&] { ++fired; });
+    wheel.tick();
+    CHECK(fired == 2);
+}
+
+// no runner callback runs before its delay has passed, wherever in a tick it was scheduled
+static void test_runner_never_early() {
+    using namespace std::chrono_literals;
+    TimingWheelRunner<Measurements::ms> runner;
+    std::mt19937 rng(4);
+
+    constexpr int count = 200;
+    std::atomic<int> done = 0, early = 0;
+    for (int i = 0; i < count; ++i) {
+        std::this_thread::sleep_for(std::chrono::microseconds(rng() % 700));
+        const auto delay = std::chrono::milliseconds(1 + rng() % 3);
+        const auto scheduled = std::chrono::steady_clock::now();
+        runner.schedule(delay, [&, delay, scheduled] {
+            if (std::chrono::steady_clock::now() - scheduled < delay) {
+                ++early;
+            }
+            ++done;
+        });
+    }
+
+    for (int waited = 0; waited < 5000 && done < count; waited += 10) {
+        std::this_thread::sleep_for(10ms);
+    }
+    CHECK(done == count);
+    CHECK(early == 0);
+}
+
+int main() {
+    test_one_shot_ticks();
+    test_periodic_and_cancel_from_callback();
+    test_runner_reschedule_from_slow_callbacks();
+    test_poll_never_early();
+    test_runner_never_early();
+    return check_result();
+}